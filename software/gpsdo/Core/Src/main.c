@@ -27,6 +27,7 @@
 #include "usb.h"
 #include "led.h"
 #include "hal.h"
+#include "profile.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -82,7 +83,7 @@ const osThreadAttr_t tsk_usb_attributes = {
 };
 /* Definitions for tsk_manager */
 osThreadId_t tsk_managerHandle;
-uint32_t tsk_managerBuffer[ 256 ];
+uint32_t tsk_managerBuffer[ 512 ];
 osStaticThreadDef_t tsk_managerControlBlock;
 const osThreadAttr_t tsk_manager_attributes = {
   .name = "tsk_manager",
@@ -92,14 +93,6 @@ const osThreadAttr_t tsk_manager_attributes = {
   .stack_size = sizeof(tsk_managerBuffer),
   .priority = (osPriority_t) osPriorityLow,
 };
-/* Definitions for xPPSSemaphore */
-osSemaphoreId_t xPPSSemaphoreHandle;
-osStaticSemaphoreDef_t xPPSSemaphoreControlBlock;
-const osSemaphoreAttr_t xPPSSemaphore_attributes = {
-  .name = "xPPSSemaphore",
-  .cb_mem = &xPPSSemaphoreControlBlock,
-  .cb_size = sizeof(xPPSSemaphoreControlBlock),
-};
 /* USER CODE BEGIN PV */
 /* Definitions for sem_IMUdataReceived */
 /* USER CODE END PV */
@@ -160,6 +153,7 @@ int main(void)
   MX_TIM2_Init();
   MX_SPI1_Init();
   /* USER CODE BEGIN 2 */
+	profile_init();
 	usb_init();
 
 	HAL_NVIC_DisableIRQ(DMA2_Stream0_IRQn);  // disable ADC1 DMA interrupt
@@ -177,10 +171,6 @@ int main(void)
 	/* add mutexes, ... */
   /* USER CODE END RTOS_MUTEX */
 
-  /* Create the semaphores(s) */
-  /* creation of xPPSSemaphore */
-  xPPSSemaphoreHandle = osSemaphoreNew(1, 0, &xPPSSemaphore_attributes);
-
   /* USER CODE BEGIN RTOS_SEMAPHORES */
 	/* add semaphores, ... */
   /* USER CODE END RTOS_SEMAPHORES */
@@ -385,6 +375,7 @@ static void MX_TIM1_Init(void)
 
   TIM_SlaveConfigTypeDef sSlaveConfig = {0};
   TIM_MasterConfigTypeDef sMasterConfig = {0};
+  TIM_IC_InitTypeDef sConfigIC = {0};
 
   /* USER CODE BEGIN TIM1_Init 1 */
 
@@ -400,6 +391,10 @@ static void MX_TIM1_Init(void)
   {
     Error_Handler();
   }
+  if (HAL_TIM_IC_Init(&htim1) != HAL_OK)
+  {
+    Error_Handler();
+  }
   sSlaveConfig.SlaveMode = TIM_SLAVEMODE_EXTERNAL1;
   sSlaveConfig.InputTrigger = TIM_TS_TI1FP1;
   sSlaveConfig.TriggerPolarity = TIM_TRIGGERPOLARITY_RISING;
@@ -414,6 +409,14 @@ static void MX_TIM1_Init(void)
   {
     Error_Handler();
   }
+  sConfigIC.ICPolarity = TIM_INPUTCHANNELPOLARITY_RISING;
+  sConfigIC.ICSelection = TIM_ICSELECTION_DIRECTTI;
+  sConfigIC.ICPrescaler = TIM_ICPSC_DIV1;
+  sConfigIC.ICFilter = 3;
+  if (HAL_TIM_IC_ConfigChannel(&htim1, &sConfigIC, TIM_CHANNEL_3) != HAL_OK)
+  {
+    Error_Handler();
+  }
   /* USER CODE BEGIN TIM1_Init 2 */
 
   /* USER CODE END TIM1_Init 2 */
@@ -18,6 +18,8 @@
 typedef enum {
     FLATBUF_MSG_STATUS = 1,
 	FLATBUF_MSG_KF_DEBUG = 2,
+	FLATBUF_MSG_PROFILE = 3,
+	FLATBUF_MSG_KF_SMOOTH = 4,
 } flatbuf_msg_id_t;
 
 typedef struct __attribute__((packed))
@@ -53,7 +55,20 @@ typedef struct {
     // Diagnostics
     uint32_t outlier_count;
     uint32_t iteration;
+    uint32_t cov_health_count;  // covariance repairs
+    uint32_t reacq_count;       // re-seeds after a run of rejections
 } KF_DebugSnapshot;
 
+typedef struct {
+    double timestamp_s;
+
+    uint32_t iteration;     // filter iteration of the smoothed sample
+    uint16_t lag;           // later samples it is conditioned on
+
+    float x[3];             // smoothed phase, frequency, drift
+    float sigma[3];         // their standard deviations
+    float x_filt[3];        // causal estimate of the same sample
+} KF_SmoothSnapshot;
+
 
 #endif /* TASKS_COM_USB_FLATBUF_DEFS_H_ */
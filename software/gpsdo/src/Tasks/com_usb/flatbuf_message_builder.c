@@ -16,9 +16,13 @@
 
 #define FB_KF_BUF_SIZE     4096
 #define FB_STATUS_BUF_SIZE  512
+#define FB_PROFILE_BUF_SIZE 256
+#define FB_SMOOTH_BUF_SIZE  256
 
 static uint8_t fb_status_out[FB_STATUS_BUF_SIZE];
 static uint8_t fb_kf_out[FB_KF_BUF_SIZE];
+static uint8_t fb_profile_out[FB_PROFILE_BUF_SIZE];
+static uint8_t fb_smooth_out[FB_SMOOTH_BUF_SIZE];
 
 static void flatbuf_send(uint16_t msg_id, const uint8_t *payload,
 		size_t payload_len) {
@@ -46,18 +50,14 @@ void flatbuf_send_kf_debug(const KF_DebugSnapshot *kf) {
 	 * Build Vec3 x
 	 * ---------------------------------------------------- */
 	gpsdo_Vec3_start(&builder);
-	gpsdo_Vec3_v_add(&builder, kf->x[0]);
-	gpsdo_Vec3_v_add(&builder, kf->x[1]);
-	gpsdo_Vec3_v_add(&builder, kf->x[2]);
+	gpsdo_Vec3_v_create(&builder, kf->x, 3);
 	gpsdo_Vec3_ref_t x_ref = gpsdo_Vec3_end(&builder);
 
 	/* ----------------------------------------------------
 	 * Build Mat3x3 P
 	 * ---------------------------------------------------- */
 	gpsdo_Mat3x3_start(&builder);
-	for (int i = 0; i < 9; i++) {
-		gpsdo_Mat3x3_m_add(&builder, kf->P[i]);
-	}
+	gpsdo_Mat3x3_m_create(&builder, kf->P, 9);
 	gpsdo_Mat3x3_ref_t P_ref = gpsdo_Mat3x3_end(&builder);
 
 	/* ----------------------------------------------------
@@ -77,27 +77,21 @@ void flatbuf_send_kf_debug(const KF_DebugSnapshot *kf) {
 	 * Build K (3x1)
 	 * ---------------------------------------------------- */
 	gpsdo_Mat3x1_start(&builder);
-	gpsdo_Mat3x1_m_add(&builder, kf->K[0]);
-	gpsdo_Mat3x1_m_add(&builder, kf->K[1]);
-	gpsdo_Mat3x1_m_add(&builder, kf->K[2]);
+	gpsdo_Mat3x1_m_create(&builder, kf->K, 3);
 	gpsdo_Mat3x1_ref_t K_ref = gpsdo_Mat3x1_end(&builder);
 
 	/* ----------------------------------------------------
 	 * Build H (1x3)
 	 * ---------------------------------------------------- */
 	gpsdo_Mat1x3_start(&builder);
-	gpsdo_Mat1x3_m_add(&builder, kf->H[0]);
-	gpsdo_Mat1x3_m_add(&builder, kf->H[1]);
-	gpsdo_Mat1x3_m_add(&builder, kf->H[2]);
+	gpsdo_Mat1x3_m_create(&builder, kf->H, 3);
 	gpsdo_Mat1x3_ref_t H_ref = gpsdo_Mat1x3_end(&builder);
 
 	/* ----------------------------------------------------
 	 * Build Q (3x3)
 	 * ---------------------------------------------------- */
 	gpsdo_Mat3x3_start(&builder);
-	for (int i = 0; i < 9; i++) {
-		gpsdo_Mat3x3_m_add(&builder, kf->Q[i]);
-	}
+	gpsdo_Mat3x3_m_create(&builder, kf->Q, 9);
 	gpsdo_Mat3x3_ref_t Q_ref = gpsdo_Mat3x3_end(&builder);
 
 	/* ----------------------------------------------------
@@ -105,7 +99,8 @@ void flatbuf_send_kf_debug(const KF_DebugSnapshot *kf) {
 	 * ---------------------------------------------------- */
 	gpsdo_kf_debug_ref_t dbg_ref = gpsdo_kf_debug_create(&builder,
 			kf->timestamp_s, state_ref, corr_ref, K_ref, H_ref, Q_ref, kf->R,
-			kf->outlier_count, kf->iteration);
+			kf->outlier_count, kf->iteration, kf->cov_health_count,
+			kf->reacq_count);
 
 	/* ----------------------------------------------------
 	 * Build Message with union payload
@@ -133,8 +128,17 @@ void flatbuf_send_kf_debug(const KF_DebugSnapshot *kf) {
 	flatcc_builder_clear(&builder);
 }
 
+static gpsdo_Vec3_ref_t flatbuf_vec3(flatcc_builder_t *builder, const float *v) {
+	gpsdo_Vec3_start(builder);
+	gpsdo_Vec3_v_create(builder, v, 3);
+	return gpsdo_Vec3_end(builder);
+}
+
 void flatbuf_send_status(float phase_cnt, float freq_error, float freq_drift,
-		float vctrl, float vmeas, float temp, uint32_t raw_counter_value) {
+		float vctrl, float vmeas, float temp, uint32_t raw_counter_value,
+		const float *mode_prob, const pps_stats_t *pps) {
+	static const pps_stats_t pps_none = { 0 };
+
 	// Select the small static arena for simple Status messages
 	flatbuf_select_status_arena();
 
@@ -142,10 +146,15 @@ void flatbuf_send_status(float phase_cnt, float freq_error, float freq_drift,
 	flatcc_builder_init(&builder);
 
 	/* ----------------------------------------------------
-	 * Build Status table
+	 * Build Status table, mode_prob left out without IMM
 	 * ---------------------------------------------------- */
+	gpsdo_Vec3_ref_t mode_ref = mode_prob ? flatbuf_vec3(&builder, mode_prob) : 0;
+	if (!pps)
+		pps = &pps_none;
 	gpsdo_Status_ref_t status = gpsdo_Status_create(&builder, phase_cnt,
-			freq_error, freq_drift, vctrl, vmeas, temp, raw_counter_value);
+			freq_error, freq_drift, vctrl, vmeas, temp, raw_counter_value,
+			mode_ref, pps->seq, pps->overruns, pps->backlog_max,
+			pps->sw_reads);
 
 	/* ----------------------------------------------------
 	 * Build Message root
@@ -172,3 +181,101 @@ void flatbuf_send_status(float phase_cnt, float freq_error, float freq_drift,
 
 	flatcc_builder_clear(&builder);
 }
+
+void flatbuf_send_profile(uint8_t section, const profile_stats_t *stats,
+		uint32_t cpu_hz) {
+	// Profile messages are small, share the Status arena
+	flatbuf_select_status_arena();
+
+	flatcc_builder_t builder;
+	flatcc_builder_init(&builder);
+
+	/* ----------------------------------------------------
+	 * Trim empty histogram buckets at both ends
+	 * ---------------------------------------------------- */
+	int first = 0;
+	int last = PROFILE_HIST_BUCKETS - 1;
+	while (first < last && stats->hist[first] == 0)
+		first++;
+	while (last > first && stats->hist[last] == 0)
+		last--;
+
+	/* ----------------------------------------------------
+	 * Build Profile table
+	 * ---------------------------------------------------- */
+	gpsdo_Profile_start(&builder);
+	gpsdo_Profile_section_add(&builder, section);
+	gpsdo_Profile_cpu_hz_add(&builder, cpu_hz);
+	gpsdo_Profile_count_add(&builder, stats->count);
+	gpsdo_Profile_min_cycles_add(&builder, stats->count ? stats->min : 0);
+	gpsdo_Profile_max_cycles_add(&builder, stats->max);
+	gpsdo_Profile_mean_cycles_add(&builder,
+			stats->count ? (float) stats->sum / (float) stats->count : 0.0f);
+	gpsdo_Profile_last_cycles_add(&builder, stats->last);
+	gpsdo_Profile_hist_first_bucket_add(&builder, (uint8_t) first);
+	gpsdo_Profile_hist_create(&builder, &stats->hist[first], last - first + 1);
+	gpsdo_Profile_ref_t profile = gpsdo_Profile_end(&builder);
+
+	/* ----------------------------------------------------
+	 * Build Message root
+	 * ---------------------------------------------------- */
+	gpsdo_Message_start_as_root(&builder);
+	gpsdo_Message_timestamp_s_add(&builder, 0.0);
+
+	gpsdo_Payload_union_ref_t ure = gpsdo_Payload_as_Profile(profile);
+	gpsdo_Message_payload_add_value(&builder, ure);
+	gpsdo_Message_payload_add_type(&builder, ure.type);
+
+	gpsdo_Message_end_as_root(&builder);
+
+	size_t msg_size;
+	const uint8_t *buf = flatcc_builder_get_direct_buffer(&builder, &msg_size);
+
+	if (msg_size <= FB_PROFILE_BUF_SIZE) {
+		memcpy(fb_profile_out, buf, msg_size);
+		flatbuf_send(FLATBUF_MSG_PROFILE, fb_profile_out, msg_size);
+	}
+
+	flatcc_builder_clear(&builder);
+}
+
+void flatbuf_send_kf_smooth(const KF_SmoothSnapshot *sm) {
+	// Sent from the controller task like Status, shares its arena
+	flatbuf_select_status_arena();
+
+	flatcc_builder_t builder;
+	flatcc_builder_init(&builder);
+
+	/* ----------------------------------------------------
+	 * Build smoothed, sigma and causal Vec3, then kf_smooth
+	 * ---------------------------------------------------- */
+	gpsdo_Vec3_ref_t x_ref = flatbuf_vec3(&builder, sm->x);
+	gpsdo_Vec3_ref_t sigma_ref = flatbuf_vec3(&builder, sm->sigma);
+	gpsdo_Vec3_ref_t filt_ref = flatbuf_vec3(&builder, sm->x_filt);
+
+	gpsdo_kf_smooth_ref_t smooth = gpsdo_kf_smooth_create(&builder,
+			sm->timestamp_s, sm->iteration, sm->lag, x_ref, sigma_ref,
+			filt_ref);
+
+	/* ----------------------------------------------------
+	 * Build Message root
+	 * ---------------------------------------------------- */
+	gpsdo_Message_start_as_root(&builder);
+	gpsdo_Message_timestamp_s_add(&builder, sm->timestamp_s);
+
+	gpsdo_Payload_union_ref_t ure = gpsdo_Payload_as_kf_smooth(smooth);
+	gpsdo_Message_payload_add_value(&builder, ure);
+	gpsdo_Message_payload_add_type(&builder, ure.type);
+
+	gpsdo_Message_end_as_root(&builder);
+
+	size_t msg_size;
+	const uint8_t *buf = flatcc_builder_get_direct_buffer(&builder, &msg_size);
+
+	if (msg_size <= FB_SMOOTH_BUF_SIZE) {
+		memcpy(fb_smooth_out, buf, msg_size);
+		flatbuf_send(FLATBUF_MSG_KF_SMOOTH, fb_smooth_out, msg_size);
+	}
+
+	flatcc_builder_clear(&builder);
+}
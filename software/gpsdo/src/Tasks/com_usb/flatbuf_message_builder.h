@@ -10,8 +10,14 @@
 
 #include <stdint.h>
 #include "flatbuf_defs.h"
+#include "profile.h"
+#include "pps.h"
 
 void flatbuf_send_kf_debug(const KF_DebugSnapshot *kf);
-void flatbuf_send_status(float phase_cnt, float freq_error, float freq_drift, float vctrl, float vmeas, float temp, uint32_t raw_counter_value);
+void flatbuf_send_status(float phase_cnt, float freq_error, float freq_drift, float vctrl, float vmeas, float temp, uint32_t raw_counter_value,
+		const float *mode_prob, // mode_prob: FILTER_IMM_MODES or NULL
+		const pps_stats_t *pps);
+void flatbuf_send_profile(uint8_t section, const profile_stats_t *stats, uint32_t cpu_hz);
+void flatbuf_send_kf_smooth(const KF_SmoothSnapshot *sm);
 
 #endif /* TASKS_COM_USB_FLATBUF_MESSAGE_BUILDER_H_ */
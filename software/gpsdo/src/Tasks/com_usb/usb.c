@@ -9,6 +9,7 @@
 #include "timers.h"
 #include "assert.h"
 #include "flatbuf_defs.h"
+#include "profile.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -69,6 +70,8 @@ void usbTask(void *argument) {
 
         if (activeQueue == xUsbTxQueue) {
             if (xQueueReceive(xUsbTxQueue, &in, 0) == pdTRUE) {
+                uint32_t t0 = profile_start();
+
                 /* Compute total message size: header + payload */
                 size_t total_len = sizeof(in.magic) + sizeof(in.msg_id) + sizeof(in.len) + in.len;
                 uint8_t *buf = (uint8_t *)&in;  // points to the start of the struct (header)
@@ -104,6 +107,8 @@ void usbTask(void *argument) {
                     /* Advance */
                     offset += chunk;
                 }
+
+                profile_stop(PROFILE_USB_TX, t0);
             }
         } else if (activeQueue == xUsbRxQueue) {
             if (xQueueReceive(xUsbRxQueue, &in, 0) == pdTRUE) {
@@ -2,10 +2,13 @@
 #include "hal.h"
 #include "led.h"
 #include "filter.h"
+#include "filter_cascade.h"
+#include "filter_smoother.h"
 #include "pps.h"
 #include "flatbuf_message_builder.h"
 #include "manager.h"
 #include "gpsdo_config.h"
+#include "profile.h"
 
 #include <math.h>
 #include <stdbool.h>
@@ -16,12 +19,30 @@
 #define DAC_SYNC_PORT GPIOA
 #define DAC_SYNC_PIN GPIO_PIN_15
 
-static const float Kp = 0.0025f;
-static const float Ki = 0.00001f;
-static const float Kd = 0.0f;
+static controller_config_t ctl_cfg = {
+	.Kp = 0.0025f,
+	.Ki = 0.00001f,
+	.Kd = 0.0f,
+	.alpha_phase = 0.02f,   // 50 s
+	.alpha_freq = 0.01f,    // 100 s
+	.alpha_drift = 0.001f,  // 1000 s
+	.steer_stage = 0,
+};
 
 static KF_DebugSnapshot kf_debug = { 0 };
 
+// EFC voltage last written to the DAC, quantized: what the oscillator runs
+// on and what the filter takes as its control input
+static float dac_volt = V_Mid;
+
+// loop state of controllerTask (EMA history and last control voltage)
+static float volt = V_Mid;
+static float freq_drift_HzDs_prev = 0.0f, prev_phase = 0.0f, prev_freq = 0.0f;
+static bool first_run = true;
+
+// section streamed as Profile telemetry on the next PPS
+static uint8_t profile_section = 0;
+
 void DAC_Select() {
 	HAL_GPIO_WritePin(DAC_CS_GPIO_Port, DAC_CS_Pin, GPIO_PIN_RESET);
 }
@@ -50,6 +71,8 @@ void DAC_AD5541A_set_value(uint16_t value) {
 }
 
 void DAC_SetVoltage(float voltage) {
+	uint32_t t0 = profile_start();
+
 	// Clamp and scale
 	if (voltage < V_Min)
 		voltage = V_Min;
@@ -58,12 +81,15 @@ void DAC_SetVoltage(float voltage) {
 
 	uint16_t value = (uint16_t) roundf((voltage / DAC_VREF) * 65535.0f);
 	DAC_AD5541A_set_value(value);
+	dac_volt = (float) value * (DAC_VREF / 65535.0f);
+
+	profile_stop(PROFILE_DAC_SET_VOLTAGE, t0);
 }
 
 float control(float phase_cnt, float freq_offset, float freq_drift) {
-	float p = Kp * freq_offset;
-	float i = Ki * phase_cnt;
-	float d = Kd * freq_drift;
+	float p = ctl_cfg.Kp * freq_offset;
+	float i = ctl_cfg.Ki * phase_cnt;
+	float d = ctl_cfg.Kd * freq_drift;
 
 	float v_out = V_Mid + p + i + d;
 
@@ -80,48 +106,120 @@ float controller_ema(float val, float prev, float alpha) {
 	return alpha * val + (1 - alpha) * prev;
 }
 
+void controller_set_config(const controller_config_t *cfg) {
+	ctl_cfg = *cfg;
+}
+
+void controller_get_config(controller_config_t *dst) {
+	*dst = ctl_cfg;
+}
+
+void controller_init(void) {
+	volt = V_Mid;
+	freq_drift_HzDs_prev = 0.0f;
+	prev_phase = 0.0f;
+	prev_freq = 0.0f;
+	first_run = true;
+	profile_section = 0;
+
+	filter_init();
+}
+
+float controller_step(uint32_t delta) {
+	uint32_t t0 = profile_start();
+	filter_set_temperature(get_temperature());
+	const bool stepped = filter_step_pps(delta, dac_volt);
+	profile_stop(PROFILE_FILTER_STEP, t0);
+
+	// a glitch interval held back: nothing new to steer from or report
+	if (!stepped)
+		return volt;
+
+	float phase_cnt = filter_get_phase_count();
+	float freq_off_Hz = filter_get_frequency_offset_Hz();
+	float freq_drift_HzDs = filter_get_frequency_drift_HzDs();
+
+	// ema smoothing
+	if(first_run)
+		first_run = false;
+	else
+	{
+		phase_cnt = controller_ema(phase_cnt, prev_phase, ctl_cfg.alpha_phase);
+		freq_off_Hz = controller_ema(freq_off_Hz, prev_freq, ctl_cfg.alpha_freq);
+		freq_drift_HzDs = controller_ema(freq_drift_HzDs, freq_drift_HzDs_prev, ctl_cfg.alpha_drift);
+	}
+
+	freq_drift_HzDs_prev = freq_drift_HzDs;
+	prev_phase = phase_cnt;
+	prev_freq = freq_off_Hz;
+
+	// steer from the block means of a slower stage once it has one; the
+	// EMAs keep running so switching back is seamless
+	filter_cascade_out_t stage;
+	if (ctl_cfg.steer_stage > 0 && cascade_get(ctl_cfg.steer_stage - 1, &stage)) {
+		freq_off_Hz = stage.x[1];
+		freq_drift_HzDs = stage.x[2];
+	}
+
+	t0 = profile_start();
+	volt = control(-phase_cnt, -freq_off_Hz, -freq_drift_HzDs);
+	profile_stop(PROFILE_CONTROL, t0);
+	//DAC_SetVoltage(volt);
+
+	// sent flatbuf, with the mode probabilities when the IMM filter runs
+	float mode_prob[FILTER_IMM_MODES];
+	const bool imm = filter_get_mode_prob(mode_prob);
+	pps_stats_t pps;
+	pps_get_stats(&pps);
+
+	t0 = profile_start();
+	flatbuf_send_status(phase_cnt, freq_off_Hz, freq_drift_HzDs, volt,
+			get_volt_meas(), get_temperature(), delta,
+			imm ? mode_prob : NULL, &pps);
+	profile_stop(PROFILE_SEND_STATUS, t0);
+
+	t0 = profile_start();
+	filter_get_kf_debug_flatbuf(&kf_debug);
+	flatbuf_send_kf_debug(&kf_debug);
+	profile_stop(PROFILE_SEND_KF_DEBUG, t0);
+
+	// one profiled section per PPS, round robin
+	profile_stats_t stats;
+	profile_get(profile_section, &stats);
+	flatbuf_send_profile(profile_section, &stats, profile_cpu_hz());
+	profile_section = (profile_section + 1) % PROFILE_SECTION_COUNT;
+
+	// smoothed state, when the manager task finished a pass
+	KF_SmoothSnapshot smooth;
+	if (smoother_take(&smooth))
+		flatbuf_send_kf_smooth(&smooth);
+
+	return volt;
+}
+
+void controller_get_output(controller_output_t *dst) {
+	dst->phase_cnt = prev_phase;
+	dst->freq_off_Hz = prev_freq;
+	dst->freq_drift_HzDs = freq_drift_HzDs_prev;
+	dst->volt = volt;
+}
+
 void controllerTask(void *argument) {
 	while (!hal_initialized)
 		osDelay(100);
 
-	static float volt = V_Mid;
-	static float freq_drift_HzDs_prev = 0.0f, prev_phase = 0.0f, prev_freq = 0.0f;
-	static bool first_run = true;
-
-	filter_init();
+	controller_init();
 	DAC_SetVoltage(volt);
 
 	while (1) {
-		osSemaphoreAcquire(xPPSSemaphoreHandle, osWaitForever);
-		toggle_led_orange();
-		uint32_t delta = pps_get_delta();
-
-		filter_step(delta, volt);
-		float phase_cnt = filter_get_phase_count();
-		float freq_off_Hz = filter_get_frequency_offset_Hz();
-		float freq_drift_HzDs = filter_get_frequency_drift_HzDs();
-
-		// ema smoothing
-		if(first_run)
-			first_run = false;
-		else
-		{
-			phase_cnt = controller_ema(phase_cnt, prev_phase, 0.02);       // 50 s
-			freq_off_Hz = controller_ema(freq_off_Hz, prev_freq, 0.01);    // 100 s
-			freq_drift_HzDs = controller_ema(freq_drift_HzDs, freq_drift_HzDs_prev, 0.001); // 1000s
+		osThreadFlagsWait(PPS_THREAD_FLAG, osFlagsWaitAny, osWaitForever);
+
+		// every edge captured since the last wake-up, oldest first, in case
+		// the USB queueing held this task past the next PPS
+		uint32_t delta;
+		while (pps_get_delta(&delta)) {
+			toggle_led_orange();
+			controller_step(delta);
 		}
-
-		freq_drift_HzDs_prev = freq_drift_HzDs;
-		prev_phase = phase_cnt;
-		prev_freq = freq_off_Hz;
-
-		volt = control(-phase_cnt, -freq_off_Hz, -freq_drift_HzDs);
-		//DAC_SetVoltage(volt);
-
-		// sent flatbuf
-		flatbuf_send_status(phase_cnt, freq_off_Hz, freq_drift_HzDs, volt,
-				get_volt_meas(), get_temperature(), delta);
-		filter_get_kf_debug_flatbuf(&kf_debug);
-		flatbuf_send_kf_debug(&kf_debug);
 	}
 }
@@ -1,4 +1,38 @@
 #ifndef TASK_CONTROLLER_H_
 #define TASK_CONTROLLER_H_
 
+#include <stdint.h>
+
+typedef struct {
+	float phase_cnt;        // EMA smoothed filter outputs fed to control()
+	float freq_off_Hz;
+	float freq_drift_HzDs;
+	float volt;             // last control voltage
+} controller_output_t;
+
+typedef struct {
+	float Kp, Ki, Kd;       // gains on frequency, phase and drift
+	float alpha_phase;      // EMA smoothing of the filter outputs
+	float alpha_freq;
+	float alpha_drift;
+	uint8_t steer_stage;    // 0: EMAs above, n: frequency and drift of
+	                        // cascade stage n - 1 (filter_cascade.h)
+} controller_config_t;
+
+void controller_set_config(const controller_config_t *cfg);
+void controller_get_config(controller_config_t *dst);
+
+void DAC_SetVoltage(float voltage);
+
+float control(float phase_cnt, float freq_offset, float freq_drift);
+float controller_ema(float val, float prev, float alpha);
+
+// One iteration of controllerTask per PPS: filter -> EMA -> control -> telemetry.
+// An interval the filter holds back (glitch pulse) keeps the last voltage.
+void controller_init(void);
+float controller_step(uint32_t delta);
+void controller_get_output(controller_output_t *dst);
+
+void controllerTask(void *argument);
+
 #endif
@@ -9,11 +9,13 @@
 #include "hal.h"
 #include "flatbuf_message_builder.h"
 #include "pps.h"
+#include "filter_smoother.h"
 
 #include <math.h>
 
 #define ADC_VREF 3.3f
 #define ADC_MAX_VALUE 4096.0f
+#define SMOOTH_PERIOD_S 10      // fixed-lag smoother pass every 10 s
 
 static float voltage__V = 0.0f;
 static float temperature__C = 0.0f;
@@ -46,17 +48,33 @@ float vref_ocxo_calc(uint16_t adc_value) {
 	return (adc_value / ADC_MAX_VALUE) * ADC_VREF;
 }
 
+// converts the latest ADC DMA samples
+void manager_sample(void) {
+	uint16_t ch1 = adc_dma_buffer[0];
+	uint16_t ch3 = adc_dma_buffer[1];
+
+	voltage__V = vref_ocxo_calc(ch1);
+	temperature__C = ntc_calc_temperature(ch3);
+}
+
+// once a second: ADC samples, and the low priority fixed-lag smoother
+// pass whose result the controller sends
+void manager_second(void) {
+	static uint32_t seconds = 0;
+
+	manager_sample();
+
+	if (++seconds % SMOOTH_PERIOD_S == 0)
+		smoother_update();
+}
+
 void mangerTask(void *argument) {
 	pps_init();
 
 	hal_initialized = 1;
 
 	for (;;) {
-		uint16_t ch1 = adc_dma_buffer[0];
-		uint16_t ch3 = adc_dma_buffer[1];
-
-		voltage__V = vref_ocxo_calc(ch1);
-		temperature__C = ntc_calc_temperature(ch3);
+		manager_second();
 
 		osDelay(1000);
 	}
@@ -8,7 +8,12 @@
 #ifndef TASKS_MANAGER_MANAGER_H_
 #define TASKS_MANAGER_MANAGER_H_
 
+#include <stdint.h>
+
 float get_volt_meas();
 float get_temperature();
+float ntc_calc_temperature(uint16_t adc_value);
+void manager_sample(void);
+void manager_second(void);
 
 #endif /* TASKS_MANAGER_MANAGER_H_ */
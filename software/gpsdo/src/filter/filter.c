@@ -3,57 +3,92 @@
  */
 
 #include "filter.h"
+#include "filter_batch.h"
+#include "filter_cascade.h"
+#include "filter_model.h"
+#include "filter_smoother.h"
 #include "gpsdo_config.h"
 #include <arm_math.h>
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
-static void filter_fill_debug(float S_val, float mahal_dist);
+static void filter_fill_debug(float S_val, float mahal_dist, bool rejected);
+static void filter_post_correct(float S_val, float mahal_dist, bool rejected);
+static void filter_record_prior(void);
+static void filter_record_posterior(bool rejected);
+static void filter_correct_phase(float z_phase);
+static void filter_batch_sample(float z_phase);
+static void filter_restart(void);
+static void filter_solve_steady_state(void);
 
 #define ARM_MATH_MATRIX_CHECK 1
 #define MAHAL_THRESHOLD   9.0f   // 3-sigma rejection
+#define FILTER_REACQ_RUN  10     // rejections in a row before re-seeding
+#define FILTER_INIT_SAMPLES 10   // samples of the batch initialisation
+
+// Tunables, applied on the next filter_init()
+static filter_config_t filter_cfg = {
+	.q = KF_Q_DEFAULT,
+	.sigma_phase = 0.3f,
+	.mahal_threshold = MAHAL_THRESHOLD,
+	.kernel = FILTER_KERNEL_SYM,
+	.steady_state = FILTER_STEADY_STATE,
+	.joseph = true,
+	.adaptive = false,
+	.imm = false,
+	.reacq_run = FILTER_REACQ_RUN,
+	.control_input = true,
+	.init_samples = FILTER_INIT_SAMPLES,
+};
+
+// Kernel in use, latched by filter_init()
+static filter_kernel_t kf_kernel = FILTER_KERNEL_SYM;
 
 static KF_DebugSnapshot kf_snapshot;
 static uint32_t kf_outlier_count = 0;
 static uint32_t kf_iteration_counter = 0;
+static uint32_t kf_cov_health_count = 0;   // P repairs (asymmetric / not PD)
+static uint32_t kf_reject_run = 0;         // consecutive rejections
+static uint32_t kf_reacq_count = 0;        // re-seeds after reacq_run of them
+static bool kf_batch = false;              // collecting the batch initialisation
+static uint16_t kf_batch_n = 0;            // ... until it holds this many
 
-// Sampling interval (seconds)
-static const float T = 1.0f;
+// ==== Model tables (filter_model.h) ====
 
-// Derived ratio: counts per oscillator cycle over interval T
-static const float r = (float) EXPECTED_CTR / ((float) F_OSC_HZ * T);
+// State transition F and F^T (N x N)
+static const float F_data[KF_N * KF_N] = KF_MATRIX(KF_F);
+static const float FT_data[KF_N * KF_N] = KF_MATRIX(KF_FT);
 
-// ==== Raw storage for matrices & vectors ====
+// Control input B (N x 1), per volt of EFC step
+static const float B_data[KF_N] = KF_VECTOR(KF_B);
 
-// State transition F (3x3)
-static float F_data[9] = { 1.0f, r * T, 0.5f * r * T * T, 0.0f, 1.0f, T, 0.0f,
-		0.0f, 1.0f };
+// Measurement matrix H (1 x N): phase only, H^T (N x 1)
+static const float H_data[KF_N] = { 1.0f };
+static const float HT_data[KF_N] = { 1.0f };
 
-// Measurement matrix H (1x3): phase only
-static float H_data[3] = { 1.0f, 0.0f, 0.0f };
-// H^T (3x1)
-static float HT_data[3] = { 1.0f, 0.0f, 0.0f };
+// Identity I (N x N)
+static const float I_data[KF_N * KF_N] = KF_MATRIX(KF_EYE);
 
-// Identity I (3x3)
-static float I_data[9] =
-		{ 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+// Process noise shape, Q = q * Qu (+ the tempco random walk)
+static const float Qu_data[KF_N * KF_N] = KF_MATRIX(KF_QU);
 
-static float Q_data[9] = { 0.0f };  // process noise (3x3)
-static float R_data[1] = { 0.0f };  // measurement noise (1x1)
-static float P_data[9] = { 0.0f };  // covariance (3x3)
-static float X_data[3] = { 0.0f };  // state (3x1)
-static float X_pred_data[3] = { 0.0f };  // predicted state (3x1)
+// ==== Raw storage for matrices & vectors ====
 
-// For prediction step
-static float FT_data[9] = { 0.0f };       // F^T (3x3)
+static float Q_data[KF_N * KF_N] = { 0.0f };  // process noise (N x N)
+static float R_data[1] = { 0.0f };  // measurement noise (1x1)
+static float P_data[KF_N * KF_N] = { 0.0f };  // covariance (N x N)
+static float X_data[KF_N] = { 0.0f };  // state (N x 1)
+static float X_pred_data[KF_N] = { 0.0f };  // predicted state (N x 1)
 
 // Temp matrices
-static float temp_3x3a_data[9] = { 0.0f };
-static float temp_3x3b_data[9] = { 0.0f };
-static float temp_1x3_data[3] = { 0.0f };  // H P (1x3)
+static float temp_NxNa_data[KF_N * KF_N] = { 0.0f };
+static float temp_NxNb_data[KF_N * KF_N] = { 0.0f };
+static float temp_NxNc_data[KF_N * KF_N] = { 0.0f };
+static float temp_1xN_data[KF_N] = { 0.0f };  // H P (1 x N)
 static float temp_1x1a_data[1] = { 0.0f };  // HPHT or inv(S) (1x1)
-static float temp_3x1a_data[3] = { 0.0f };  // P HT (3x1)
-static float temp_3x1b_data[3] = { 0.0f };  // K y (3x1)
+static float temp_Nx1a_data[KF_N] = { 0.0f };  // P HT (N x 1)
+static float temp_Nx1b_data[KF_N] = { 0.0f };  // K y (N x 1)
 
 // Measurement and innovation
 static float z_data[1] = { 0.0f };   // z = measured phase (cycles)
@@ -62,17 +97,169 @@ static float y_data[1] = { 0.0f };   // innovation
 // HX = H * X_pred
 static float HX_data[1] = { 0.0f };
 
-// Kalman gain K (3x1)
-static float K_data[3] = { 0.0f };
+// ==== Extended precision phase ====
+// Whole cycles are moved out of the phase state once it reaches
+// FILTER_PHASE_REBASE, so X[0], z and the innovation stay small residuals
+// and keep their float resolution however far the phase runs.
+#define FILTER_PHASE_REBASE  1.0f
+
+static int64_t kf_phase_base = 0;          // whole cycles under X[0]
+static filter_phase_t kf_meas_phase;       // sum of raw_count - EXPECTED_CTR
+
+// ==== Temperature input (4-state model) ====
+#if KF_N == 4
+static float kf_temp_C = 0.0f;         // latest filter_set_temperature()
+static float kf_temp_prev_C = 0.0f;    // at the previous prediction
+static bool kf_temp_valid = false;     // kf_temp_prev_C holds a sample
+static float kf_temp_dT = 0.0f;        // input of the current step
+static bool kf_temp_fresh = false;     // set since the last prediction
+
+// G = I + u e3^T for the CMSIS path, u = (r T dT / 2, dT, 0, 0)
+static float G_data[KF_N * KF_N] = KF_MATRIX(KF_EYE);
+static float GT_data[KF_N * KF_N] = KF_MATRIX(KF_EYE);
+#endif
+
+// ==== Control input ====
+// The EFC voltage is known: its step since the last prediction enters as
+// x_pred += B dv instead of as a frequency jump the innovations have to
+// reveal. P is untouched, the input carries no noise of its own.
+static float kf_v_prev = 0.0f;         // voltage at the previous prediction
+static bool kf_v_valid = false;        // kf_v_prev holds a sample
+static float kf_dv = 0.0f;             // input of the current step
+
+// Kalman gain K (N x 1), K^T shares the storage
+static float K_data[KF_N] = { 0.0f };
+
+// ==== Symmetric kernel ====
+// Upper triangle of P and Q, row by row (KF_IDX)
+static float Ps_data[KF_NS] = { 0.0f };
+static float Qs_data[KF_NS] = { 0.0f };
+static const float Ps_init[KF_NS] = KF_UPPER(KF_P0);  // also the P repair
+
+// Top-left block of x, P, K, H, Q in the 3-state debug snapshot
+#define KF_DEBUG_N  (KF_N < 3 ? KF_N : 3)
+
+// ==== Covariance health ====
+#define FILTER_SYM_TOL   1e-5f   // |Pij - Pji| relative to sqrt(Pii Pjj)
+
+// ==== Steady state (constant gain) ====
+#define FILTER_SS_MAX_ITER     20000
+#define FILTER_SS_SOLVE_TOL    1e-9    // relative gain change ending the solve
+#define FILTER_SS_SWITCH_TOL   1e-3f   // relative distance of K to K_ss
+
+static float K_ss[KF_N] = { 0.0f };
+static float Ps_pred_ss[KF_NS] = { 0.0f };  // prior covariance
+static float Ps_post_ss[KF_NS] = { 0.0f };  // posterior covariance
+static float S_ss = 0.0f;
+static bool ss_valid = false;           // the solve converged
+static bool kf_steady = false;          // running on K_ss
+
+// ==== Adaptive noise (covariance matching) ====
+// R from the innovation variance, E[y^2] = H P- H^T + R, and q from the
+// whiteness of the normalized innovations: a lagging filter (q too small)
+// leaves them positively correlated, an overreacting one negatively.
+// Both over a sliding window, changed only when the window statistic is
+// significant and by at most FILTER_ADAPT_STEP per update. Outliers enter
+// winsorized at the gate: dropping them would bias R low.
+#define FILTER_ADAPT_WINDOW    64      // innovations in the sliding window
+#define FILTER_ADAPT_EVERY     16      // innovations between updates
+#define FILTER_ADAPT_WARMUP    256     // innovations after init, P transient
+#define FILTER_ADAPT_STEP      1.1f    // max factor per update
+#define FILTER_ADAPT_R_MIN     (1.0f / 12.0f) // counter quantization
+#define FILTER_ADAPT_R_MAX     100.0f
+#define FILTER_ADAPT_Q_RANGE   1e3f    // q within cfg.q / x .. cfg.q * x
+
+static float kf_q = 0.0f;                        // q behind Q_data
+static float adapt_nu[FILTER_ADAPT_WINDOW];      // y / sqrt(S)
+static float adapt_r[FILTER_ADAPT_WINDOW];       // y^2 - H P- H^T
+static uint32_t adapt_count = 0;                 // innovations since init
+
+// ==== Interacting multiple model (IMM) ====
+// One model per filter_mode_t. They share F and Q, the oscillator does not
+// care about the sky, and differ in R only. Every step mixes the model
+// estimates by the mode switching probabilities, runs the closed form
+// kernel on each model and weights the modes by the likelihood of the
+// innovation. A degraded stretch then moves weight to the wider models
+// instead of being gated sample by sample or followed.
+static const float imm_r_scale[FILTER_IMM_MODES] = { 1.0f, 1e2f, 1e4f };
+
+// Mode switching per sample, row: from, column: to
+static const float imm_pi[FILTER_IMM_MODES][FILTER_IMM_MODES] = {
+	{ 0.990f, 0.008f, 0.002f },
+	{ 0.030f, 0.960f, 0.010f },
+	{ 0.010f, 0.030f, 0.960f },
+};
+static const float imm_mu_init[FILTER_IMM_MODES] = { 0.98f, 0.01f, 0.01f };
+
+static bool kf_imm = false;                        // latched by filter_init()
+static float imm_mu[FILTER_IMM_MODES];             // mode probabilities
+static float imm_c[FILTER_IMM_MODES];              // ... predicted
+static float imm_x[FILTER_IMM_MODES][KF_N];
+static float imm_x_pred[FILTER_IMM_MODES][KF_N];
+static float imm_P[FILTER_IMM_MODES][KF_NS];       // packed, prior or posterior
+
+// ==== PPS gaps ====
+// filter_step_pps() takes the counter interval between two pulses. A missed
+// pulse makes it span several seconds, a glitch pulse splits a second in
+// two. Whole seconds are recognised from the count; an interval further
+// than FILTER_GAP_TOL counts per second from a whole number of seconds is
+// held back and added to the next one. If the sum is not whole either but
+// the next interval is, the PPS phase stepped and the held one is dropped.
+#define FILTER_GAP_TOL   5000    // counts per second, 1000 ppm
+#define FILTER_GAP_MAX   600     // seconds, the 32 bit counter wraps at 858
+
+static uint32_t gap_pending = 0;       // counts of the interval held back
+static uint32_t kf_gap_seconds = 0;    // predicted across, no measurement
+static uint32_t kf_glitch_count = 0;   // intervals held back or dropped
+
+// P(i, j) of the packed upper triangle, any i, j
+static inline float sym_at(const float *sym, int i, int j) {
+	return i <= j ? sym[KF_IDX(i, j)] : sym[KF_IDX(j, i)];
+}
+
+static inline void sym_pack(const float *full, float *sym) {
+	for (int i = 0; i < KF_N; i++)
+		for (int j = i; j < KF_N; j++)
+			sym[KF_IDX(i, j)] = full[i * KF_N + j];
+}
+
+static inline void sym_unpack(const float *sym, float *full) {
+	for (int i = 0; i < KF_N; i++)
+		for (int j = i; j < KF_N; j++)
+			full[i * KF_N + j] = full[j * KF_N + i] = sym[KF_IDX(i, j)];
+}
 
 // ==== CMSIS matrix instances ====
-static arm_matrix_instance_f32 F, FT, H, HT, Q, R, I;
-static arm_matrix_instance_f32 P, X, X_pred, HX;
-static arm_matrix_instance_f32 temp_3x3a, temp_3x3b;
-static arm_matrix_instance_f32 temp_1x3, temp_1x1a;
-static arm_matrix_instance_f32 temp_3x1a, temp_3x1b;
-static arm_matrix_instance_f32 z, y;
-static arm_matrix_instance_f32 K;
+// Sizes are static, so the instances are constant initializers. The model
+// tables are only ever read through them.
+#define KF_MAT(rows, cols, data)  { (rows), (cols), (float32_t *) (data) }
+
+static arm_matrix_instance_f32 F = KF_MAT(KF_N, KF_N, F_data);
+static arm_matrix_instance_f32 FT = KF_MAT(KF_N, KF_N, FT_data);
+static arm_matrix_instance_f32 B = KF_MAT(KF_N, 1, B_data);
+static arm_matrix_instance_f32 H = KF_MAT(1, KF_N, H_data);
+static arm_matrix_instance_f32 HT = KF_MAT(KF_N, 1, HT_data);
+static arm_matrix_instance_f32 Q = KF_MAT(KF_N, KF_N, Q_data);
+static arm_matrix_instance_f32 I = KF_MAT(KF_N, KF_N, I_data);
+static arm_matrix_instance_f32 P = KF_MAT(KF_N, KF_N, P_data);
+static arm_matrix_instance_f32 X = KF_MAT(KF_N, 1, X_data);
+static arm_matrix_instance_f32 X_pred = KF_MAT(KF_N, 1, X_pred_data);
+static arm_matrix_instance_f32 HX = KF_MAT(1, 1, HX_data);
+static arm_matrix_instance_f32 temp_NxNa = KF_MAT(KF_N, KF_N, temp_NxNa_data);
+static arm_matrix_instance_f32 temp_NxNb = KF_MAT(KF_N, KF_N, temp_NxNb_data);
+static arm_matrix_instance_f32 temp_NxNc = KF_MAT(KF_N, KF_N, temp_NxNc_data);
+static arm_matrix_instance_f32 temp_1xN = KF_MAT(1, KF_N, temp_1xN_data);
+static arm_matrix_instance_f32 temp_1x1a = KF_MAT(1, 1, temp_1x1a_data);
+static arm_matrix_instance_f32 temp_Nx1a = KF_MAT(KF_N, 1, temp_Nx1a_data);
+static arm_matrix_instance_f32 temp_Nx1b = KF_MAT(KF_N, 1, temp_Nx1b_data);
+static arm_matrix_instance_f32 z = KF_MAT(1, 1, z_data);
+static arm_matrix_instance_f32 y = KF_MAT(1, 1, y_data);
+static arm_matrix_instance_f32 K = KF_MAT(KF_N, 1, K_data);
+static arm_matrix_instance_f32 KT = KF_MAT(1, KF_N, K_data);
+#if KF_N == 4
+static arm_matrix_instance_f32 G = KF_MAT(KF_N, KF_N, G_data);
+static arm_matrix_instance_f32 GT = KF_MAT(KF_N, KF_N, GT_data);
+#endif
 
 // Simple memcpy helper
 static inline void mat_copy(const arm_matrix_instance_f32 *src,
@@ -80,85 +267,664 @@ static inline void mat_copy(const arm_matrix_instance_f32 *src,
 	memcpy(dst->pData, src->pData, src->numRows * src->numCols * sizeof(float));
 }
 
+// acc += whole + frac, keeping |acc->frac| <= 0.5
+static void filter_phase_add(filter_phase_t *acc, int64_t whole, float frac) {
+	float f = acc->frac + frac;
+	const float n = rintf(f);
+
+	acc->cycles += whole + (int64_t) n;
+	acc->frac = f - n;
+}
+
+// Moves the whole cycles of the predicted phase into kf_phase_base
+static void filter_rebase_phase(void) {
+	if (fabsf(X_pred_data[KF_PHASE]) < FILTER_PHASE_REBASE)
+		return;
+
+	const float n = rintf(X_pred_data[KF_PHASE]);
+	X_pred_data[KF_PHASE] -= n;
+	X_data[KF_PHASE] -= n;
+	kf_phase_base += (int64_t) n;
+
+	if (kf_imm) {
+		for (int j = 0; j < FILTER_IMM_MODES; j++) {
+			imm_x_pred[j][KF_PHASE] -= n;
+			imm_x[j][KF_PHASE] -= n;
+		}
+	}
+}
+
+// Q = q Qu (+ the tempco random walk), full and packed
+static void filter_set_q(float q) {
+	kf_q = q;
+	for (int i = 0; i < KF_N * KF_N; i++)
+		Q_data[i] = q * Qu_data[i];
+#if KF_N == 4
+	Q_data[KF_TEMPCO * KF_N + KF_TEMPCO] = KF_Q_TEMPCO * FILTER_T;
+#endif
+	sym_pack(Q_data, Qs_data);
+}
+
 void filter_init(void) {
-	// ---- Process noise Q (constant-acceleration style) ----
+	// ---- Process noise Q (integrated white noise, filter_model.h) ----
 	// Tunable scalar q: bigger -> filter responds faster, noisier
-	const float q = 1e-7f;
-
-	Q_data[0] = q * T * T * T * T * T / 20.0f;
-	Q_data[1] = q * T * T * T * T / 8.0f;
-	Q_data[2] = q * T * T * T / 6.0f;
-	Q_data[3] = q * T * T * T * T / 8.0f;
-	Q_data[4] = q * T * T * T / 3.0f;
-	Q_data[5] = q * T * T / 2.0f;
-	Q_data[6] = q * T * T * T / 6.0f;
-	Q_data[7] = q * T * T / 2.0f;
-	Q_data[8] = q * T;
+	filter_set_q(filter_cfg.q);
 
 	// ---- Measurement noise R ----
 	// Measurement is raw_count - EXPECTED_CTR in cycles at 5 MHz.
 	// For 1 second gate and ±1 count resolution, σ_phase ≈ 0.29 cycles.
-	const float sigma_phase = 0.3f; // cycles (tunable)
+	const float sigma_phase = filter_cfg.sigma_phase; // cycles (tunable)
 	R_data[0] = sigma_phase * sigma_phase;  // 1x1
 
-	// ---- Initial covariance P ----
-	// Phase:   ±0.2 cycles
-	// Freq:    ±2 Hz
-	// Drift:   ±0.02 Hz/s
-	memset(P_data, 0, sizeof(P_data));
-	P_data[0] = 0.20f * 0.20f;
-	P_data[4] = 2.0f * 2.0f;
-	P_data[8] = 0.02f * 0.02f;
-
-	// ---- State ----
-	X_data[0] = 0.0f; // phase
-	X_data[1] = 0.0f; // frequency offset (Hz)
-	X_data[2] = 0.0f; // drift (Hz/s)
+	// ---- Initial covariance P (KF_P0) ----
+	memcpy(Ps_data, Ps_init, sizeof(Ps_data));
+	sym_unpack(Ps_data, P_data);
 
+	// ---- State: phase, frequency offset (Hz), drift (Hz/s), tempco ----
+	memset(X_data, 0, sizeof(X_data));
 	memcpy(X_pred_data, X_data, sizeof(X_data));
 
-	// ---- Matrix instances ----
-	arm_mat_init_f32(&F, 3, 3, F_data);
-	arm_mat_init_f32(&FT, 3, 3, FT_data);
-	arm_mat_init_f32(&H, 1, 3, H_data);
-	arm_mat_init_f32(&HT, 3, 1, HT_data);
-	arm_mat_init_f32(&Q, 3, 3, Q_data);
-	arm_mat_init_f32(&R, 1, 1, R_data);
-	arm_mat_init_f32(&I, 3, 3, I_data);
+	kf_phase_base = 0;
+	kf_meas_phase.cycles = 0;
+	kf_meas_phase.frac = 0.0f;
 
-	arm_mat_init_f32(&P, 3, 3, P_data);
-	arm_mat_init_f32(&X, 3, 1, X_data);
-	arm_mat_init_f32(&X_pred, 3, 1, X_pred_data);
+#if KF_N == 4
+	kf_temp_valid = false;
+	kf_temp_dT = 0.0f;
+	kf_temp_fresh = false;
+#endif
 
-	arm_mat_init_f32(&HX, 1, 1, HX_data);
-	arm_mat_init_f32(&z, 1, 1, z_data);
-	arm_mat_init_f32(&y, 1, 1, y_data);
+	kf_v_valid = false;
+	kf_dv = 0.0f;
 
-	arm_mat_init_f32(&temp_3x3a, 3, 3, temp_3x3a_data);
-	arm_mat_init_f32(&temp_3x3b, 3, 3, temp_3x3b_data);
-	arm_mat_init_f32(&temp_1x3, 1, 3, temp_1x3_data);
-	arm_mat_init_f32(&temp_1x1a, 1, 1, temp_1x1a_data);
-	arm_mat_init_f32(&temp_3x1a, 3, 1, temp_3x1a_data);
-	arm_mat_init_f32(&temp_3x1b, 3, 1, temp_3x1b_data);
+	kf_cov_health_count = 0;
+	kf_reject_run = 0;
+	kf_reacq_count = 0;
+	gap_pending = 0;
+	kf_gap_seconds = 0;
+	kf_glitch_count = 0;
+	adapt_count = 0;
+	smoother_reset();
+	cascade_reset();
 
-	arm_mat_init_f32(&K, 3, 1, K_data);
+	// at least one sample more than the chain has states
+	kf_batch_n = filter_cfg.init_samples;
+	if (kf_batch_n > FILTER_BATCH_MAX)
+		kf_batch_n = FILTER_BATCH_MAX;
+	if (kf_batch_n > 0 && kf_batch_n <= KF_CHAIN)
+		kf_batch_n = KF_CHAIN + 1;
+	kf_batch = kf_batch_n > 0;
+	batch_reset();
+	memset(K_data, 0, sizeof(K_data));
+	kf_kernel = filter_cfg.kernel;
+
+	// IMM models start at the single filter's x and P
+	kf_imm = filter_cfg.imm && kf_kernel == FILTER_KERNEL_SYM;
+	for (int j = 0; j < FILTER_IMM_MODES; j++) {
+		imm_mu[j] = imm_mu_init[j];
+		memcpy(imm_x[j], X_data, sizeof(X_data));
+		memcpy(imm_P[j], Ps_init, sizeof(Ps_init));
+	}
 
-	// Precompute F^T
-	arm_mat_trans_f32(&F, &FT);
+	// the DARE gain only holds for fixed Q and R, a single model
+	kf_steady = false;
+	if (kf_kernel == FILTER_KERNEL_SYM && filter_cfg.steady_state
+			&& !filter_cfg.adaptive && !kf_imm && KF_TIME_INVARIANT)
+		filter_solve_steady_state();
+	else
+		ss_valid = false;
+}
+
+// P = F P F^T + Q on the upper triangle. F is upper triangular with a unit
+// diagonal; F_data is constant, so once the loops unroll the zero terms
+// drop out and what is left is the closed form for the chosen N.
+static void sym_predict_cov(float *p) {
+	float m[KF_NS];
+
+	// M = F P, only the upper triangle F P F^T needs
+	KF_UNROLL
+	for (int i = 0; i < KF_N; i++) {
+		for (int j = i; j < KF_N; j++) {
+			float s = sym_at(p, i, j);
+			for (int k = i + 1; k < KF_N; k++) {
+				if (F_data[i * KF_N + k] != 0.0f)
+					s += F_data[i * KF_N + k] * sym_at(p, k, j);
+			}
+			m[KF_IDX(i, j)] = s;
+		}
+	}
+
+	// P = M F^T
+	KF_UNROLL
+	for (int i = 0; i < KF_N; i++) {
+		for (int j = i; j < KF_N; j++) {
+			float s = m[KF_IDX(i, j)];
+			for (int k = j + 1; k < KF_N; k++) {
+				if (F_data[j * KF_N + k] != 0.0f)
+					s += m[KF_IDX(i, k)] * F_data[j * KF_N + k];
+			}
+			p[KF_IDX(i, j)] = s;
+		}
+	}
+
+#if KF_N == 4
+	// P = G P G^T = P + u c^T + c u^T + c3 u u^T, c = P(:, TEMPCO)
+	if (kf_temp_dT != 0.0f) {
+		const float u[2] = { 0.5f * KF_R * FILTER_T * kf_temp_dT, kf_temp_dT };
+		float c[KF_N];
+
+		for (int i = 0; i < KF_N; i++)
+			c[i] = sym_at(p, i, KF_TEMPCO);
+		for (int i = 0; i < 2; i++) {
+			for (int j = i; j < KF_N; j++) {
+				float d = u[i] * c[j];
+				if (j < 2)
+					d += c[i] * u[j] + c[KF_TEMPCO] * u[i] * u[j];
+				p[KF_IDX(i, j)] += d;
+			}
+		}
+	}
+#endif
+
+	KF_UNROLL
+	for (int i = 0; i < KF_NS; i++)
+		p[i] += Qs_data[i];
+}
+
+// H = [1 0 ..]: K = P(:,0) / S, P = (I - K H) P = P - K P(0,:),
+// a symmetric rank-1 downdate
+static void sym_correct_cov(float *p, float S, float *k) {
+	float c[KF_N];
+	const float invS = 1.0f / S;
+
+	KF_UNROLL
+	for (int i = 0; i < KF_N; i++) {
+		c[i] = p[KF_IDX(0, i)];
+		k[i] = c[i] * invS;
+	}
+
+	if (!filter_cfg.joseph) {
+		for (int i = 0; i < KF_N; i++)
+			for (int j = i; j < KF_N; j++)
+				p[KF_IDX(i, j)] -= k[i] * c[j];
+		return;
+	}
+
+	// Joseph form (I - KH) P (I - KH)^T + K R K^T, expanded:
+	// Pij -= Ki Pj0 + Kj Pi0 - Ki Kj S. The expansion loses the factored
+	// form's PSD guarantee under rounding; filter_cov_health() repairs P.
+	KF_UNROLL
+	for (int i = 0; i < KF_N; i++)
+		for (int j = i; j < KF_N; j++)
+			p[KF_IDX(i, j)] -= k[i] * c[j] + k[j] * c[i] - k[i] * k[j] * S;
+}
+
+// LDL^T: every pivot positive
+static bool sym_is_pd(const float *p) {
+	float d[KF_N];
+	float l[KF_N][KF_N];
+
+	KF_UNROLL
+	for (int j = 0; j < KF_N; j++) {
+		float dj = p[KF_IDX(j, j)];
+		for (int k = 0; k < j; k++)
+			dj -= l[j][k] * l[j][k] * d[k];
+		if (!(dj > 0.0f))
+			return false;
+		d[j] = dj;
+
+		if (j == KF_N - 1)
+			break;
+		const float inv = 1.0f / dj;
+		for (int i = j + 1; i < KF_N; i++) {
+			float s = p[KF_IDX(j, i)];
+			for (int k = 0; k < j; k++)
+				s -= l[i][k] * l[j][k] * d[k];
+			l[i][j] = s * inv;
+		}
+	}
+	return true;
+}
+
+// Checks P after an update: symmetrizes P_data (CMSIS path) and resets P
+// to its initial value when it is no longer positive definite. Every
+// repair is counted in the debug snapshot.
+static void filter_cov_health(void) {
+	bool repaired = false;
+
+	if (kf_kernel == FILTER_KERNEL_CMSIS) {
+		for (int i = 0; i < KF_N; i++) {
+			for (int j = i + 1; j < KF_N; j++) {
+				float *a = &P_data[i * KF_N + j];
+				float *b = &P_data[j * KF_N + i];
+				float scale = sqrtf(fabsf(P_data[i * KF_N + i]
+						* P_data[j * KF_N + j]));
+
+				if (fabsf(*a - *b) > FILTER_SYM_TOL * scale)
+					repaired = true;
+				*a = *b = 0.5f * (*a + *b);
+			}
+		}
+		sym_pack(P_data, Ps_data);
+	}
+
+	if (!sym_is_pd(Ps_data)) {
+		repaired = true;
+		memcpy(Ps_data, Ps_init, sizeof(Ps_data));
+		if (kf_kernel == FILTER_KERNEL_CMSIS)
+			sym_unpack(Ps_data, P_data);
+	}
+
+	if (repaired)
+		kf_cov_health_count++;
+}
+
+// Solves the DARE by running the covariance recursion from the initial P
+// until the gain settles. F, Q and R are constant, so this is the gain the
+// full filter converges to. Done once, in double: the float recursion only
+// settles to ~1e-4 on the small drift terms.
+static void filter_solve_steady_state(void) {
+	double p[KF_NS], m[KF_NS], k[KF_N], k_prev[KF_N] = { 0.0 };
+	double S = 0.0;
+
+	for (int i = 0; i < KF_NS; i++)
+		p[i] = Ps_data[i];
+	ss_valid = false;
+
+	for (uint32_t n = 0; n < FILTER_SS_MAX_ITER; n++) {
+		// predict, as sym_predict_cov()
+		for (int i = 0; i < KF_N; i++) {
+			for (int j = i; j < KF_N; j++) {
+				double s = 0.0;
+				for (int l = i; l < KF_N; l++) {
+					s += F_data[i * KF_N + l]
+							* (l <= j ? p[KF_IDX(l, j)] : p[KF_IDX(j, l)]);
+				}
+				m[KF_IDX(i, j)] = s;
+			}
+		}
+		for (int i = 0; i < KF_N; i++) {
+			for (int j = i; j < KF_N; j++) {
+				double s = 0.0;
+				for (int l = j; l < KF_N; l++)
+					s += m[KF_IDX(i, l)] * F_data[j * KF_N + l];
+				p[KF_IDX(i, j)] = s + Qs_data[KF_IDX(i, j)];
+			}
+		}
+
+		for (int i = 0; i < KF_NS; i++)
+			Ps_pred_ss[i] = (float) p[i];
+
+		// correct, as sym_correct_cov()
+		double c[KF_N];
+		S = p[KF_IDX(0, 0)] + R_data[0];
+		for (int i = 0; i < KF_N; i++) {
+			c[i] = p[KF_IDX(0, i)];
+			k[i] = c[i] / S;
+		}
+		for (int i = 0; i < KF_N; i++)
+			for (int j = i; j < KF_N; j++)
+				p[KF_IDX(i, j)] -= k[i] * c[j];
+
+		bool settled = true;
+		for (int i = 0; i < KF_N; i++) {
+			if (fabs(k[i] - k_prev[i]) > FILTER_SS_SOLVE_TOL * fabs(k[i]))
+				settled = false;
+		}
+		if (settled) {
+			ss_valid = true;
+			break;
+		}
+		memcpy(k_prev, k, sizeof(k));
+	}
+
+	for (int i = 0; i < KF_N; i++)
+		K_ss[i] = (float) k[i];
+	for (int i = 0; i < KF_NS; i++)
+		Ps_post_ss[i] = (float) p[i];
+	S_ss = (float) S;
+}
+
+// The running gain is close enough to K_ss to stop propagating P
+static bool filter_gain_converged(void) {
+	for (int i = 0; i < KF_N; i++) {
+		if (fabsf(K_data[i] - K_ss[i]) > FILTER_SS_SWITCH_TOL * fabsf(K_ss[i]))
+			return false;
+	}
+	return true;
+}
+
+static float clampf(float x, float lo, float hi) {
+	return x < lo ? lo : (x > hi ? hi : x);
+}
+
+// Feeds one innovation into the window and re-estimates R and q
+static void filter_adapt_noise(float innov, float S_val) {
+	const float gate = filter_cfg.mahal_threshold;
+	const float hph = S_val - R_data[0];
+	float nu = innov / sqrtf(S_val);
+
+	nu = clampf(nu, -sqrtf(gate), sqrtf(gate));
+	const uint32_t slot = adapt_count % FILTER_ADAPT_WINDOW;
+	adapt_nu[slot] = nu;
+	adapt_r[slot] = nu * nu * S_val - hph;
+	adapt_count++;
+
+	if (adapt_count < FILTER_ADAPT_WARMUP
+			|| adapt_count % FILTER_ADAPT_EVERY != 0)
+		return;
+
+	const float n = (float) FILTER_ADAPT_WINDOW;
+	float r_sum = 0.0f, r_sq = 0.0f, nu_sq = 0.0f, nu_lag = 0.0f;
+	for (uint32_t i = 0; i < FILTER_ADAPT_WINDOW; i++) {
+		const uint32_t prev = (i + FILTER_ADAPT_WINDOW - 1) % FILTER_ADAPT_WINDOW;
+		r_sum += adapt_r[i];
+		r_sq += adapt_r[i] * adapt_r[i];
+		nu_sq += adapt_nu[i] * adapt_nu[i];
+		// the oldest sample has no predecessor in the window
+		if (i != (adapt_count % FILTER_ADAPT_WINDOW))
+			nu_lag += adapt_nu[i] * adapt_nu[prev];
+	}
+
+	// R: mean of the samples, if it is off by more than 2 standard errors
+	const float r_mean = r_sum / n;
+	const float r_se = sqrtf(fmaxf(r_sq / n - r_mean * r_mean, 0.0f) / n);
+	float r = R_data[0];
+	if (fabsf(r_mean - r) > 2.0f * r_se) {
+		r = clampf(r_mean, r / FILTER_ADAPT_STEP, r * FILTER_ADAPT_STEP);
+		r = clampf(r, FILTER_ADAPT_R_MIN, FILTER_ADAPT_R_MAX);
+	}
+
+	// q: lag-1 autocorrelation outside the 2 / sqrt(n) band of white noise
+	float q = kf_q;
+	if (nu_sq > 0.0f) {
+		const float rho = nu_lag / nu_sq;
+		if (rho > 2.0f / sqrtf(n))
+			q *= FILTER_ADAPT_STEP;
+		else if (rho < -2.0f / sqrtf(n))
+			q /= FILTER_ADAPT_STEP;
+		q = clampf(q, filter_cfg.q / FILTER_ADAPT_Q_RANGE,
+				filter_cfg.q * FILTER_ADAPT_Q_RANGE);
+	}
+
+	if (r == R_data[0] && q == kf_q)
+		return;
+
+	R_data[0] = r;
+	filter_set_q(q);
+}
+
+// x_pred = F x, F upper triangular with a unit diagonal
+static void sym_predict_state(const float *x, float *x_pred) {
+	KF_UNROLL
+	for (int i = 0; i < KF_N; i++) {
+		float s = x[i];
+		for (int k = i + 1; k < KF_N; k++) {
+			if (F_data[i * KF_N + k] != 0.0f)
+				s += F_data[i * KF_N + k] * x[k];
+		}
+		x_pred[i] = s;
+	}
+#if KF_N == 4
+	x_pred[KF_PHASE] += 0.5f * KF_R * FILTER_T * kf_temp_dT * x[KF_TEMPCO];
+	x_pred[KF_FREQ] += kf_temp_dT * x[KF_TEMPCO];
+#endif
+	if (kf_dv != 0.0f) {
+		for (int i = 0; i < KF_N; i++)
+			x_pred[i] += B_data[i] * kf_dv;
+	}
+}
+
+static void filter_predict_sym(void) {
+	sym_predict_state(X_data, X_pred_data);
+
+	// steady state: P stays at the DARE solution, nothing to propagate
+	if (!kf_steady)
+		sym_predict_cov(Ps_data);
+}
+
+static void filter_correct_sym(float z_phase) {
+	z_data[0] = z_phase;
+	HX_data[0] = X_pred_data[KF_PHASE];
+	y_data[0] = z_phase - X_pred_data[KF_PHASE];
+
+	const float S_val = kf_steady ? S_ss : Ps_data[KF_IDX(0, 0)] + R_data[0];
+	const float innov = y_data[0];
+	const float mahal_dist = (innov * innov) / S_val;
+
+	if (mahal_dist > filter_cfg.mahal_threshold) {
+		kf_outlier_count++;
+		memcpy(X_data, X_pred_data, sizeof(X_data));
+
+		// uncorrected step: resume the full recursion from the prior
+		if (kf_steady) {
+			kf_steady = false;
+			memcpy(Ps_data, Ps_pred_ss, sizeof(Ps_data));
+		}
+
+		filter_post_correct(S_val, mahal_dist, true);
+		return;
+	}
+
+	// in steady state K_data already holds K_ss
+	if (!kf_steady) {
+		sym_correct_cov(Ps_data, S_val, K_data);
+		filter_cov_health();
+
+		if (filter_cfg.steady_state && ss_valid && filter_gain_converged()) {
+			kf_steady = true;
+			memcpy(K_data, K_ss, sizeof(K_data));
+			memcpy(Ps_data, Ps_post_ss, sizeof(Ps_data));
+		}
+	}
+
+	for (int i = 0; i < KF_N; i++)
+		X_data[i] = X_pred_data[i] + K_data[i] * innov;
+
+	filter_post_correct(S_val, mahal_dist, false);
+}
+
+// x = sum w_j x_j, P = sum w_j (P_j + (x_j - x) (x_j - x)^T): the moments
+// of the model mixture, for the mixing and for the combined estimate
+static void imm_combine(const float *w, float (*x)[KF_N], float (*p)[KF_NS],
+		float *x_out, float *p_out) {
+	memset(x_out, 0, KF_N * sizeof(float));
+	memset(p_out, 0, KF_NS * sizeof(float));
+
+	for (int j = 0; j < FILTER_IMM_MODES; j++)
+		for (int i = 0; i < KF_N; i++)
+			x_out[i] += w[j] * x[j][i];
+
+	for (int j = 0; j < FILTER_IMM_MODES; j++) {
+		float d[KF_N];
+		for (int i = 0; i < KF_N; i++)
+			d[i] = x[j][i] - x_out[i];
+
+		KF_UNROLL
+		for (int i = 0; i < KF_N; i++)
+			for (int k = i; k < KF_N; k++)
+				p_out[KF_IDX(i, k)] += w[j] * (p[j][KF_IDX(i, k)] + d[i] * d[k]);
+	}
+}
+
+static void filter_predict_imm(void) {
+	float x0[FILTER_IMM_MODES][KF_N];
+	float p0[FILTER_IMM_MODES][KF_NS];
+
+	// mixing: model j starts from the estimates weighted pi_ij mu_i / c_j,
+	// c_j = sum_i pi_ij mu_i the predicted mode probability
+	for (int j = 0; j < FILTER_IMM_MODES; j++) {
+		float w[FILTER_IMM_MODES];
+
+		imm_c[j] = 0.0f;
+		for (int i = 0; i < FILTER_IMM_MODES; i++) {
+			w[i] = imm_pi[i][j] * imm_mu[i];
+			imm_c[j] += w[i];
+		}
+		for (int i = 0; i < FILTER_IMM_MODES; i++)
+			w[i] /= imm_c[j];
+		imm_combine(w, imm_x, imm_P, x0[j], p0[j]);
+	}
+
+	for (int j = 0; j < FILTER_IMM_MODES; j++) {
+		sym_predict_state(x0[j], imm_x_pred[j]);
+		memcpy(imm_P[j], p0[j], sizeof(p0[j]));
+		sym_predict_cov(imm_P[j]);
+	}
+
+	// combined prior, for the phase rebase and the smoother history
+	imm_combine(imm_c, imm_x_pred, imm_P, X_pred_data, Ps_data);
+}
+
+static void filter_correct_imm(float z_phase) {
+	float log_l[FILTER_IMM_MODES], k[FILTER_IMM_MODES][KF_N];
+	float log_max = -INFINITY, S_val = 0.0f, norm = 0.0f;
+	bool rejected = true;
+
+	for (int j = 0; j < FILTER_IMM_MODES; j++) {
+		const float innov = z_phase - imm_x_pred[j][KF_PHASE];
+		const float S = imm_P[j][KF_IDX(0, 0)] + imm_r_scale[j] * R_data[0];
+		const float d2 = innov * innov / S;
+
+		// Gaussian log likelihood, less the common log(2 pi) / 2
+		log_l[j] = -0.5f * (d2 + logf(S));
+		log_max = fmaxf(log_max, log_l[j]);
+		S_val += imm_c[j] * S;
+
+		// every model keeps the gate, the clear sky one coasts over a
+		// glitch while the wider ones take it with a small gain
+		memset(k[j], 0, sizeof(k[j]));
+		if (d2 > filter_cfg.mahal_threshold) {
+			memcpy(imm_x[j], imm_x_pred[j], sizeof(imm_x[j]));
+			continue;
+		}
+		rejected = false;
+
+		sym_correct_cov(imm_P[j], S, k[j]);
+		if (!sym_is_pd(imm_P[j])) {
+			memcpy(imm_P[j], Ps_init, sizeof(Ps_init));
+			kf_cov_health_count++;
+		}
+		for (int i = 0; i < KF_N; i++)
+			imm_x[j][i] = imm_x_pred[j][i] + k[j][i] * innov;
+	}
+
+	// mu_j ~ L_j c_j, scaled by the largest likelihood against underflow
+	for (int j = 0; j < FILTER_IMM_MODES; j++) {
+		imm_mu[j] = imm_c[j] * expf(log_l[j] - log_max);
+		norm += imm_mu[j];
+	}
+	memset(K_data, 0, sizeof(K_data));
+	for (int j = 0; j < FILTER_IMM_MODES; j++) {
+		imm_mu[j] /= norm;
+		for (int i = 0; i < KF_N; i++)
+			K_data[i] += imm_mu[j] * k[j][i];
+	}
+
+	imm_combine(imm_mu, imm_x, imm_P, X_data, Ps_data);
+
+	z_data[0] = z_phase;
+	HX_data[0] = X_pred_data[KF_PHASE];
+	y_data[0] = z_phase - X_pred_data[KF_PHASE];
+	if (rejected)
+		kf_outlier_count++;
+
+	filter_post_correct(S_val, y_data[0] * y_data[0] / S_val, rejected);
+}
+
+#if KF_N == 4
+// dT since the previous prediction; 0 without a fresh, plausible sample
+static void filter_update_temp_input(void) {
+	kf_temp_dT = 0.0f;
+	if (!kf_temp_fresh)
+		return;
+
+	const float dT = kf_temp_C - kf_temp_prev_C;
+	if (kf_temp_valid && fabsf(dT) <= KF_TEMP_STEP_MAX)
+		kf_temp_dT = dT;
+
+	kf_temp_prev_C = kf_temp_C;
+	kf_temp_valid = true;
+	kf_temp_fresh = false;
+}
+#endif
+
+// EFC step since the previous prediction
+static void filter_update_control_input(float v) {
+	kf_dv = (filter_cfg.control_input && kf_v_valid) ? v - kf_v_prev : 0.0f;
+	kf_v_prev = v;
+	kf_v_valid = true;
 }
 
 void filter_predict(float v) {
-	// X_pred = F * X
-	arm_mat_mult_f32(&F, &X, &X_pred);
+#if KF_N == 4
+	filter_update_temp_input();
+#endif
+	filter_update_control_input(v);
+
+	if (kf_imm) {
+		filter_predict_imm();
+	} else if (kf_kernel == FILTER_KERNEL_SYM) {
+		filter_predict_sym();
+	} else {
+		// X_pred = F * X
+		arm_mat_mult_f32(&F, &X, &X_pred);
+
+		// P = F P F^T + Q
+		arm_mat_mult_f32(&F, &P, &temp_NxNa);  // temp_NxNa = FP
+		arm_mat_mult_f32(&temp_NxNa, &FT, &temp_NxNb); // temp_NxNb = FPF^T
+#if KF_N == 4
+		// temperature input: X_pred = G X_pred, P = G P G^T
+		const float u0 = 0.5f * KF_R * FILTER_T * kf_temp_dT;
+		G_data[KF_PHASE * KF_N + KF_TEMPCO] = u0;
+		G_data[KF_FREQ * KF_N + KF_TEMPCO] = kf_temp_dT;
+		GT_data[KF_TEMPCO * KF_N + KF_PHASE] = u0;
+		GT_data[KF_TEMPCO * KF_N + KF_FREQ] = kf_temp_dT;
+
+		mat_copy(&X_pred, &temp_Nx1a);
+		arm_mat_mult_f32(&G, &temp_Nx1a, &X_pred);
+		arm_mat_mult_f32(&G, &temp_NxNb, &temp_NxNa);
+		arm_mat_mult_f32(&temp_NxNa, &GT, &temp_NxNb);
+#endif
+		arm_mat_add_f32(&temp_NxNb, &Q, &P);     // P = FPF^T + Q
 
-	// P = F P F^T + Q
-	arm_mat_mult_f32(&F, &P, &temp_3x3a);  // temp_3x3a = FP
-	arm_mat_mult_f32(&temp_3x3a, &FT, &temp_3x3b); // temp_3x3b = FPF^T
-	arm_mat_add_f32(&temp_3x3b, &Q, &P);     // P = FPF^T + Q
+		// control input: X_pred += B dv
+		if (kf_dv != 0.0f) {
+			arm_mat_scale_f32(&B, kf_dv, &temp_Nx1a);
+			mat_copy(&X_pred, &temp_Nx1b);
+			arm_mat_add_f32(&temp_Nx1b, &temp_Nx1a, &X_pred);
+		}
+	}
+
+	filter_rebase_phase();
+	filter_record_prior();
 }
 
 void filter_correct(float raw_count) {
-	float z_phase = raw_count - (float) EXPECTED_CTR;
+	// raw_count - EXPECTED_CTR with the whole cycles in integer, then
+	// relative to the phase base the filter state is kept against
+	const float whole = rintf(raw_count);
+	const float frac = raw_count - whole;
+	const int64_t dz = (int64_t) whole - (int64_t) EXPECTED_CTR;
+
+	filter_phase_add(&kf_meas_phase, dz, frac);
+	filter_correct_phase((float) (dz - kf_phase_base) + frac);
+}
+
+static void filter_correct_phase(float z_phase) {
+	if (kf_batch) {
+		filter_batch_sample(z_phase);
+		return;
+	}
+	if (kf_imm) {
+		filter_correct_imm(z_phase);
+		return;
+	}
+	if (kf_kernel == FILTER_KERNEL_SYM) {
+		filter_correct_sym(z_phase);
+		return;
+	}
+
 	z_data[0] = z_phase;
 
 	// y = z - H * X_pred
@@ -166,8 +932,8 @@ void filter_correct(float raw_count) {
 	arm_mat_sub_f32(&z, &HX, &y);        // y = z - HX
 
 	// S = H P H^T + R
-	arm_mat_mult_f32(&H, &P, &temp_1x3);   // temp_1x3 = HP
-	arm_mat_mult_f32(&temp_1x3, &HT, &temp_1x1a); // temp_1x1a = HPH^T
+	arm_mat_mult_f32(&H, &P, &temp_1xN);   // temp_1xN = HP
+	arm_mat_mult_f32(&temp_1xN, &HT, &temp_1x1a); // temp_1x1a = HPH^T
 
 	// temp_1x1a = S = HPHT + R
 	temp_1x1a_data[0] += R_data[0];
@@ -180,11 +946,11 @@ void filter_correct(float raw_count) {
 	float mahal_dist = (innov * innov) / S_val;
 
 	// Outlier detected — skip correction
-	if (mahal_dist > MAHAL_THRESHOLD) {
+	if (mahal_dist > filter_cfg.mahal_threshold) {
 		kf_outlier_count++;
 	    mat_copy(&X_pred, &X);
 
-	    filter_fill_debug(S_val, mahal_dist);
+	    filter_post_correct(S_val, mahal_dist, true);
 	    return;
 	}
 
@@ -192,22 +958,32 @@ void filter_correct(float raw_count) {
 	temp_1x1a_data[0] = invS;   // reuse temp_1x1a as inv(S)
 
 	// K = P H^T inv(S)
-	arm_mat_mult_f32(&P, &HT, &temp_3x1a);        // temp_3x1a = P H^T
-	arm_mat_mult_f32(&temp_3x1a, &temp_1x1a, &K); // K = P H^T * inv(S)
+	arm_mat_mult_f32(&P, &HT, &temp_Nx1a);        // temp_Nx1a = P H^T
+	arm_mat_mult_f32(&temp_Nx1a, &temp_1x1a, &K); // K = P H^T * inv(S)
 
 	// X = X_pred + K y
-	arm_mat_mult_f32(&K, &y, &temp_3x1b);  // temp_3x1b = K y
-	arm_mat_add_f32(&X_pred, &temp_3x1b, &X);
+	arm_mat_mult_f32(&K, &y, &temp_Nx1b);  // temp_Nx1b = K y
+	arm_mat_add_f32(&X_pred, &temp_Nx1b, &X);
 
 	// P = (I - K H) P
-	arm_mat_mult_f32(&K, &H, &temp_3x3a);         // temp_3x3a = K H
-	arm_mat_sub_f32(&I, &temp_3x3a, &temp_3x3b);  // temp_3x3b = I - K H
-	arm_mat_mult_f32(&temp_3x3b, &P, &temp_3x3a); // temp_3x3a = (I - K H) P
+	arm_mat_mult_f32(&K, &H, &temp_NxNa);         // temp_NxNa = K H
+	arm_mat_sub_f32(&I, &temp_NxNa, &temp_NxNb);  // temp_NxNb = I - K H
+	arm_mat_mult_f32(&temp_NxNb, &P, &temp_NxNa); // temp_NxNa = (I - K H) P
+
+	if (filter_cfg.joseph) {
+		// P = (I - K H) P (I - K H)^T + K R K^T
+		arm_mat_trans_f32(&temp_NxNb, &temp_NxNc);          // (I - K H)^T
+		arm_mat_mult_f32(&temp_NxNa, &temp_NxNc, &temp_NxNb);
+		arm_mat_mult_f32(&K, &KT, &temp_NxNa);              // K K^T
+		arm_mat_scale_f32(&temp_NxNa, R_data[0], &temp_NxNc); // K R K^T
+		arm_mat_add_f32(&temp_NxNb, &temp_NxNc, &temp_NxNa);
+	}
 
 	// Copy back to P
-	mat_copy(&temp_3x3a, &P);
+	mat_copy(&temp_NxNa, &P);
+	filter_cov_health();
 
-    filter_fill_debug(S_val, mahal_dist);
+    filter_post_correct(S_val, mahal_dist, false);
 }
 
 void filter_step(float raw, float v) {
@@ -217,43 +993,335 @@ void filter_step(float raw, float v) {
 	kf_iteration_counter++;
 }
 
+// Posterior = prior, for a step without a measurement
+static void filter_take_prior(void) {
+	if (kf_imm) {
+		// no likelihood, the mode probabilities follow the switching
+		for (int j = 0; j < FILTER_IMM_MODES; j++) {
+			memcpy(imm_x[j], imm_x_pred[j], sizeof(imm_x[j]));
+			imm_mu[j] = imm_c[j];
+		}
+		imm_combine(imm_mu, imm_x, imm_P, X_data, Ps_data);
+	} else {
+		memcpy(X_data, X_pred_data, sizeof(X_data));
+		if (kf_steady) {
+			kf_steady = false;
+			memcpy(Ps_data, Ps_pred_ss, sizeof(Ps_data));
+		}
+	}
+}
+
+// A step without a measurement: the posterior is the prediction
+static void filter_coast(void) {
+	filter_take_prior();
+	filter_record_posterior(true);
+	kf_iteration_counter++;
+}
+
+// Whole seconds n within FILTER_GAP_TOL per second, dz the counts over them
+static bool filter_gap_whole(uint64_t total, uint64_t *n, int64_t *dz) {
+	const uint64_t expected = (uint64_t) EXPECTED_CTR;
+
+	*n = (total + expected / 2) / expected;
+	*dz = (int64_t) total - (int64_t) (*n * expected);
+	return *n > 0 && llabs(*dz) <= (int64_t) *n * FILTER_GAP_TOL;
+}
+
+bool filter_step_pps(uint32_t count, float v) {
+	uint64_t n;
+	int64_t dz;
+
+	// a glitch pulse split the second: the held-back interval and this one
+	// add up to whole seconds again (both terms 32 bit, the sum may not be)
+	if (!filter_gap_whole((uint64_t) gap_pending + count, &n, &dz)) {
+		// At most one interval is held back. This one being whole seconds
+		// on its own means the PPS phase stepped (receiver restart): the
+		// remainder is dropped and the filter carries on from here.
+		if (gap_pending == 0 || !filter_gap_whole(count, &n, &dz)) {
+			kf_glitch_count++;
+			gap_pending = count;
+			return false;
+		}
+	}
+	gap_pending = 0;
+
+	// longer than the counter can be trusted to not have wrapped: predict
+	// across what it can bridge, then start over without the count
+	if (n > FILTER_GAP_MAX) {
+		kf_gap_seconds += FILTER_GAP_MAX;
+		for (uint32_t i = 0; i < FILTER_GAP_MAX; i++) {
+			filter_predict(v);
+			filter_coast();
+		}
+		filter_restart();
+		return true;
+	}
+
+	// n - 1 missed pulses: predict across them, then correct with the mean
+	// count excess per second over the whole interval
+	kf_gap_seconds += (uint32_t) (n - 1);
+	for (uint32_t i = 1; i < n; i++) {
+		filter_predict(v);
+		filter_coast();
+	}
+
+	const int64_t whole = dz / (int64_t) n;
+	const float frac = (float) (dz - whole * (int64_t) n) / (float) n;
+
+	filter_predict(v);
+	filter_phase_add(&kf_meas_phase, dz, 0.0f);
+	filter_correct_phase((float) (whole - kf_phase_base) + frac);
+
+	kf_iteration_counter++;
+	return true;
+}
+
+void filter_get_gap_stats(uint32_t *gap_seconds, uint32_t *glitches) {
+	*gap_seconds = kf_gap_seconds;
+	*glitches = kf_glitch_count;
+}
+
+
+// ---- History for the fixed-lag smoother (filter_smoother.c) ----
+static void filter_record_prior(void) {
+	float Ps[KF_NS];
+	const float *p = Ps;
+
+	// in steady state Ps_data stays at the posterior
+	if (kf_kernel == FILTER_KERNEL_SYM)
+		p = kf_steady ? Ps_pred_ss : Ps_data;
+	else
+		sym_pack(P_data, Ps);
+
+#if KF_N == 4
+	smoother_record_prior(X_pred_data, p, kf_temp_dT);
+#else
+	smoother_record_prior(X_pred_data, p, 0.0f);
+#endif
+}
+
+static void filter_record_posterior(bool rejected) {
+	static const float K_none[KF_N];
+	float Ps[KF_NS];
+	const float *p = Ps;
+
+	if (kf_kernel == FILTER_KERNEL_SYM)
+		p = Ps_data;
+	else
+		sym_pack(P_data, Ps);
+
+	smoother_record_posterior(X_data, p, kf_phase_base, kf_iteration_counter);
+
+	// a rejected sample leaves the posterior at the prediction
+#if KF_N == 4
+	cascade_record(X_data, p, rejected ? K_none : K_data, kf_phase_base,
+			kf_temp_dT, kf_iteration_counter);
+#else
+	cascade_record(X_data, p, rejected ? K_none : K_data, kf_phase_base,
+			0.0f, kf_iteration_counter);
+#endif
+}
+
+// Restarts the recursion from X_data and Ps_data, every IMM model alike,
+// and drops the history the smoother and cascade hold from before
+static void filter_seed(void) {
+	sym_unpack(Ps_data, P_data);
+	kf_steady = false;
+
+	if (kf_imm) {
+		for (int j = 0; j < FILTER_IMM_MODES; j++) {
+			memcpy(imm_x[j], X_data, sizeof(imm_x[j]));
+			memcpy(imm_P[j], Ps_data, sizeof(imm_P[j]));
+		}
+		memcpy(imm_mu, imm_mu_init, sizeof(imm_mu));
+	}
+
+	smoother_reset();
+	cascade_reset();
+}
+
+// A run of reacq_run rejections is a step the gate will never let through,
+// a receiver restart or antenna swap. Re-seed the phase from the latest
+// measurement and open P back up to its initial value.
+static void filter_reacquire(void) {
+	X_data[KF_PHASE] = z_data[0];
+	memcpy(Ps_data, Ps_init, sizeof(Ps_data));
+	filter_seed();
+	kf_reacq_count++;
+}
+
+// After a gap the count cannot bridge: the phase is only known from the
+// prediction. Open P back up to its initial value around it, or collect a
+// new batch initialisation when the filter started with one.
+static void filter_restart(void) {
+	memcpy(Ps_data, Ps_init, sizeof(Ps_data));
+	filter_seed();
+	kf_reacq_count++;
+
+	kf_batch = kf_batch_n > 0;
+	batch_reset();
+}
+
+// Batch initialisation: from filter_init() the prediction runs on from
+// X = 0 through the known inputs (control and temperature) without being
+// corrected, and the innovations against it are collected. The fit over
+// kf_batch_n of them is the correction of the last one. Unlike the
+// recursion from X = 0 and P0 it needs no guess of the initial offset
+// and has no gate to hold the first samples out with.
+// Each collected sample still records its posterior (the prediction) and
+// a debug snapshot; it reads as rejected, no gain was applied.
+static void filter_batch_sample(float z_phase) {
+	z_data[0] = z_phase;
+	HX_data[0] = X_pred_data[KF_PHASE];
+	y_data[0] = z_phase - X_pred_data[KF_PHASE];
+	batch_add(y_data[0], kf_iteration_counter);
+	filter_take_prior();
+
+	const float S_val = (kf_kernel == FILTER_KERNEL_SYM ?
+			Ps_data[KF_IDX(KF_PHASE, KF_PHASE)] :
+			P_data[KF_PHASE * KF_N + KF_PHASE]) + R_data[0];
+	const float mahal_dist = y_data[0] * y_data[0] / S_val;
+	bool solved = false;
 
-static void filter_fill_debug(float S_val, float mahal_dist) {
+	if (batch_count() >= kf_batch_n) {
+		kf_batch = false;
+
+		float dx[KF_N] = { 0.0f };
+		float Ps[KF_NS];
+		memcpy(Ps, Ps_init, sizeof(Ps));    // the tempco keeps its P0
+		// on failure carry on from the prediction, reacq_run catches up
+		solved = batch_solve(filter_cfg.sigma_phase,
+				sqrtf(filter_cfg.mahal_threshold), dx, Ps);
+		if (solved) {
+			for (int i = 0; i < KF_N; i++)
+				X_data[i] += dx[i];
+			memcpy(Ps_data, Ps, sizeof(Ps_data));
+			filter_seed();
+		}
+	}
+
+	filter_record_posterior(!solved);
+	filter_fill_debug(S_val, mahal_dist, !solved);
+}
+
+// Every innovation, accepted or rejected, ends here
+static void filter_post_correct(float S_val, float mahal_dist, bool rejected) {
+	kf_reject_run = rejected ? kf_reject_run + 1 : 0;
+	if (filter_cfg.reacq_run && kf_reject_run >= filter_cfg.reacq_run) {
+		filter_reacquire();
+		kf_reject_run = 0;
+	}
+
+	filter_record_posterior(rejected);
+	filter_fill_debug(S_val, mahal_dist, rejected);
+	if (filter_cfg.adaptive && !kf_imm)
+		filter_adapt_noise(y_data[0], S_val);
+}
+
+static void filter_fill_debug(float S_val, float mahal_dist, bool rejected) {
     kf_snapshot.timestamp_s = 0.0f; //get_timestamp_seconds();
 
-    kf_snapshot.x[0] = X_data[0];
-    kf_snapshot.x[1] = X_data[1];
-    kf_snapshot.x[2] = X_data[2];
-    memcpy(kf_snapshot.P, P_data, sizeof(float)*9);
+    const float base = (float) kf_phase_base;
+
+    if (kf_kernel == FILTER_KERNEL_SYM)
+        sym_unpack(Ps_data, P_data);
 
-    kf_snapshot.z  = z_data[0];
-    kf_snapshot.h_x = HX_data[0];
+    // the snapshot carries phase, frequency and drift; entries a 2-state
+    // model has no state for stay zero
+    for (int i = 0; i < KF_DEBUG_N; i++) {
+        kf_snapshot.x[i] = X_data[i];
+        kf_snapshot.K[i] = K_data[i];
+        kf_snapshot.H[i] = H_data[i];
+        for (int j = 0; j < KF_DEBUG_N; j++) {
+            kf_snapshot.P[i * 3 + j] = P_data[i * KF_N + j];
+            kf_snapshot.Q[i * 3 + j] = Q_data[i * KF_N + j];
+        }
+    }
+    kf_snapshot.x[0] += base;
+
+    kf_snapshot.z  = base + z_data[0];
+    kf_snapshot.h_x = base + HX_data[0];
     kf_snapshot.y = y_data[0];
     kf_snapshot.S = S_val;
     kf_snapshot.mahal_d2 = mahal_dist;
     kf_snapshot.nis = mahal_dist;
-    kf_snapshot.rejected = (mahal_dist > MAHAL_THRESHOLD);
+    kf_snapshot.rejected = rejected;
 
-    memcpy(kf_snapshot.K, K_data, sizeof(float)*3);
-    memcpy(kf_snapshot.H, H_data, sizeof(float)*3);
-    memcpy(kf_snapshot.Q, Q_data, sizeof(float)*9);
     kf_snapshot.R = R_data[0];
 
     kf_snapshot.outlier_count = kf_outlier_count;
+    kf_snapshot.cov_health_count = kf_cov_health_count;
+    kf_snapshot.reacq_count = kf_reacq_count;
     kf_snapshot.iteration = kf_iteration_counter;
 }
 
+void filter_set_temperature(float temp_C) {
+#if KF_N == 4
+	kf_temp_C = temp_C;
+	kf_temp_fresh = true;
+#else
+	(void) temp_C;
+#endif
+}
+
+// ------------ CONFIG ------------
+void filter_set_config(const filter_config_t *cfg) {
+	filter_cfg = *cfg;
+}
+
+void filter_get_config(filter_config_t *dst) {
+	*dst = filter_cfg;
+}
+
 // ------------ GETTERS ------------
 float filter_get_phase_count(void) {
-	return X_data[0];
+	return (float) kf_phase_base + X_data[0];
+}
+
+void filter_get_phase_ext(filter_phase_t *dst) {
+	dst->cycles = kf_phase_base;
+	dst->frac = 0.0f;
+	filter_phase_add(dst, 0, X_data[0]);
+}
+
+void filter_get_measured_phase(filter_phase_t *dst) {
+	*dst = kf_meas_phase;
 }
 
 float filter_get_frequency_offset_Hz(void) {
-	return X_data[1];
+	return X_data[KF_FREQ];
 }
 
 float filter_get_frequency_drift_HzDs(void) {
-	return X_data[2];
+#if KF_N >= 3
+	return X_data[KF_DRIFT];
+#else
+	return 0.0f;
+#endif
+}
+
+float filter_get_tempco_HzDC(void) {
+#if KF_N == 4
+	return X_data[KF_TEMPCO];
+#else
+	return 0.0f;
+#endif
+}
+
+float filter_get_q(void) {
+	return kf_q;
+}
+
+bool filter_is_steady_state(void) {
+	return kf_steady;
+}
+
+bool filter_get_mode_prob(float *dst) {
+	if (!kf_imm)
+		return false;
+
+	memcpy(dst, imm_mu, sizeof(imm_mu));
+	return true;
 }
 
 void filter_get_kf_debug_flatbuf(KF_DebugSnapshot *dst)
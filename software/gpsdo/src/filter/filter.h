@@ -11,18 +11,90 @@
 #include <stdint.h>
 #include "flatbuf_defs.h"
 
+// Number of states: 2 (phase, frequency), 3 (+ drift) or 4 (+ frequency
+// temperature coefficient). Build flag, the model is in filter_model.h.
+#ifndef FILTER_STATES
+#define FILTER_STATES 3
+#endif
+
+// Default of filter_config_t.steady_state. Off: the constant DARE gain
+// drifts from the time-varying one (equivalence.py --steady-state
+// diverges), so it is an opt-in, here or through filter_set_config().
+#ifndef FILTER_STEADY_STATE
+#define FILTER_STEADY_STATE 0
+#endif
+
+// Implementation of filter_predict()/filter_correct()
+typedef enum {
+	FILTER_KERNEL_SYM = 0,  // closed form, H = [1 0 ..], packed symmetric P
+	FILTER_KERNEL_CMSIS,    // generic arm_mat_* path
+} filter_kernel_t;
+
+// Modes of the IMM filter, filter_get_mode_prob() order
+typedef enum {
+	FILTER_MODE_CLEAR = 0,  // clear sky, the configured R
+	FILTER_MODE_DEGRADED,   // multipath
+	FILTER_MODE_JAMMED,     // jammed or spoofed, close to holdover
+	FILTER_IMM_MODES,
+} filter_mode_t;
+
+// Extended precision phase: whole cycles plus a float residual
+typedef struct {
+	int64_t cycles;
+	float frac;             // |frac| <= 0.5
+} filter_phase_t;
+
+typedef struct {
+	float q;                // process noise: bigger -> faster, noisier
+	float sigma_phase;      // measurement noise (cycles)
+	float mahal_threshold;  // innovation D^2 above this is rejected
+	filter_kernel_t kernel;
+	bool steady_state;      // switch to the DARE gain once K has converged
+	bool joseph;            // Joseph form covariance update
+	bool adaptive;          // re-estimate R and q from the innovations
+	bool imm;               // one model per filter_mode_t (closed form kernel)
+	uint16_t reacq_run;     // consecutive rejections that re-seed the
+	                        // filter from the measurement, 0: never
+	bool control_input;     // predict the EFC voltage steps (KF_B)
+	uint16_t init_samples;  // least-squares fit over the first samples
+	                        // after filter_init() seeds X and P, 0: X = 0, P0
+} filter_config_t;
+
+void filter_set_config(const filter_config_t *cfg);
+void filter_get_config(filter_config_t *dst);
+
 void filter_init(void);
+// voltage_ctrl: the EFC voltage on the DAC for the coming interval
 void filter_predict(float voltage_ctrl);
 void filter_correct(float raw_count);
 
 void filter_step(float raw_count, float voltage_ctrl);
 
+// One PPS interval of the 5 MHz counter. Spanning several seconds (missed
+// pulses) it predicts across the gap and corrects with the mean count per
+// second; a fraction of a second (glitch pulse) is added to the next one,
+// or dropped as a PPS phase step when the next one is whole on its own.
+// Beyond FILTER_GAP_MAX seconds it predicts that far and re-seeds.
+// False for an interval held back, the filter did not step.
+bool filter_step_pps(uint32_t count, float voltage_ctrl);
+
+// Oscillator temperature, the known input of the 4-state model. Latched
+// by the next filter_predict(); ignored by the 2 and 3-state models.
+void filter_set_temperature(float temp_C);
+
 bool filter_pre_check(float delta);
 float filter_ema(float x, float prev_y, float alpha);
 
 float filter_get_phase_count();
 float filter_get_frequency_offset_Hz();
 float filter_get_frequency_drift_HzDs();
+float filter_get_tempco_HzDC(void);   // Hz/°C, 4-state model only
+float filter_get_q(void);             // q in use (adaptive mode moves it)
+bool filter_is_steady_state(void);
+bool filter_get_mode_prob(float *dst);  // FILTER_IMM_MODES, false without IMM
+void filter_get_phase_ext(filter_phase_t *dst);
+void filter_get_measured_phase(filter_phase_t *dst);
 void filter_get_kf_debug_flatbuf(KF_DebugSnapshot *dst);
+void filter_get_gap_stats(uint32_t *gap_seconds, uint32_t *glitches);
 
 #endif /* FILTER_FILTER_H_ */
@@ -0,0 +1,150 @@
+/*
+ * filter_batch.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "filter_batch.h"
+#include "filter_model.h"
+
+#include <math.h>
+#include <string.h>
+
+#define BATCH_M      KF_CHAIN   // phase, frequency (, drift); not the tempco
+#define BATCH_IRLS   3          // fits: plain, then Huber re-weighted
+
+typedef struct {
+	float innov;
+	uint32_t t;
+} batch_sample_t;
+
+static batch_sample_t samples[FILTER_BATCH_MAX];
+static uint16_t n_samples = 0;
+
+void batch_reset(void) {
+	n_samples = 0;
+}
+
+void batch_add(float innov, uint32_t t) {
+	if (n_samples < FILTER_BATCH_MAX)
+		samples[n_samples++] = (batch_sample_t ) { innov, t };
+}
+
+uint16_t batch_count(void) {
+	return n_samples;
+}
+
+// Phase row of F(tau): the sample tau seconds (<= 0) before the newest one
+// seen from the chain state at the newest one
+static void batch_row(float tau, double *a) {
+	double p = 1.0;
+
+	a[0] = 1.0;
+	for (int j = 1; j < BATCH_M; j++) {
+		p *= (double) tau / (double) j;
+		a[j] = (double) KF_R * p;
+	}
+}
+
+// In place Cholesky factor of the M x M normal matrix (lower triangle)
+static bool batch_cholesky(double *n) {
+	for (int j = 0; j < BATCH_M; j++) {
+		double d = n[j * BATCH_M + j];
+		for (int k = 0; k < j; k++)
+			d -= n[j * BATCH_M + k] * n[j * BATCH_M + k];
+		if (!(d > 0.0))
+			return false;
+		d = sqrt(d);
+		n[j * BATCH_M + j] = d;
+
+		for (int i = j + 1; i < BATCH_M; i++) {
+			double s = n[i * BATCH_M + j];
+			for (int k = 0; k < j; k++)
+				s -= n[i * BATCH_M + k] * n[j * BATCH_M + k];
+			n[i * BATCH_M + j] = s / d;
+		}
+	}
+	return true;
+}
+
+// x = (L L^T)^-1 b
+static void batch_cho_solve(const double *l, const double *b, double *x) {
+	for (int i = 0; i < BATCH_M; i++) {
+		double s = b[i];
+		for (int k = 0; k < i; k++)
+			s -= l[i * BATCH_M + k] * x[k];
+		x[i] = s / l[i * BATCH_M + i];
+	}
+	for (int i = BATCH_M - 1; i >= 0; i--) {
+		double s = x[i];
+		for (int k = i + 1; k < BATCH_M; k++)
+			s -= l[k * BATCH_M + i] * x[k];
+		x[i] = s / l[i * BATCH_M + i];
+	}
+}
+
+/*
+ * Iteratively re-weighted least squares: the first fit weights every
+ * sample by 1 / sigma^2, the following ones scale that by
+ * min(1, gate sigma / |residual|), so a glitch the gate would have
+ * rejected pulls the fit linearly instead of quadratically. The
+ * covariance (A^T W A)^-1 is that of the last fit. Double precision: the
+ * normal matrix spans tau^4 over the batch, and it runs once per boot.
+ */
+bool batch_solve(float sigma, float gate, float *dx, float *Ps) {
+	if (n_samples <= BATCH_M || !(sigma > 0.0f))
+		return false;
+
+	const uint32_t t_last = samples[n_samples - 1].t;
+	const double w0 = 1.0 / ((double) sigma * (double) sigma);
+	double w[FILTER_BATCH_MAX];
+	double n[BATCH_M * BATCH_M], x[BATCH_M];
+
+	for (int k = 0; k < n_samples; k++)
+		w[k] = w0;
+
+	for (int it = 0; it < BATCH_IRLS; it++) {
+		double b[BATCH_M] = { 0.0 };
+		double a[BATCH_M];
+
+		memset(n, 0, sizeof(n));
+		for (int k = 0; k < n_samples; k++) {
+			batch_row(-(float) (t_last - samples[k].t) * FILTER_T, a);
+			for (int i = 0; i < BATCH_M; i++) {
+				b[i] += w[k] * a[i] * samples[k].innov;
+				for (int j = 0; j <= i; j++)
+					n[i * BATCH_M + j] += w[k] * a[i] * a[j];
+			}
+		}
+
+		if (!batch_cholesky(n))
+			return false;
+		batch_cho_solve(n, b, x);
+		if (it == BATCH_IRLS - 1)
+			break;
+
+		// Huber weights for the next fit
+		for (int k = 0; k < n_samples; k++) {
+			batch_row(-(float) (t_last - samples[k].t) * FILTER_T, a);
+			double r = samples[k].innov;
+			for (int i = 0; i < BATCH_M; i++)
+				r -= a[i] * x[i];
+
+			const double u = fabs(r) / (double) sigma;
+			w[k] = u > (double) gate ? w0 * (double) gate / u : w0;
+		}
+	}
+
+	// P = (L L^T)^-1, column by column
+	for (int j = 0; j < BATCH_M; j++) {
+		double e[BATCH_M] = { 0.0 }, c[BATCH_M];
+		e[j] = 1.0;
+		batch_cho_solve(n, e, c);
+		for (int i = 0; i <= j; i++)
+			Ps[KF_IDX(i, j)] = (float) c[i];
+	}
+
+	for (int i = 0; i < BATCH_M; i++)
+		dx[i] = (float) x[i];
+	return true;
+}
@@ -0,0 +1,34 @@
+/*
+ * filter_batch.h
+ *
+ *  Batch initialiser of the Kalman filter. After filter_init() the first
+ *  samples are only collected; a weighted least-squares fit of the phase,
+ *  frequency and drift chain over them then gives the filter its initial
+ *  X and P, instead of starting from X = 0 and the hand-picked P0.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef FILTER_FILTER_BATCH_H_
+#define FILTER_FILTER_BATCH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Most samples a fit can take (8 bytes each)
+#define FILTER_BATCH_MAX  64
+
+void batch_reset(void);
+
+// Innovation of the sample at filter iteration t against the prediction
+// the filter carried through the batch (the response to the known inputs)
+void batch_add(float innov, uint32_t t);
+uint16_t batch_count(void);
+
+// Fit at the newest sample: dx is added to the filter's prediction there,
+// Ps (packed, KF_NS) is the covariance of the fit. The samples are weighted
+// by 1 / sigma^2 and down-weighted (Huber) beyond gate sigma of the fit.
+// False if the samples do not determine the chain.
+bool batch_solve(float sigma, float gate, float *dx, float *Ps);
+
+#endif /* FILTER_FILTER_BATCH_H_ */
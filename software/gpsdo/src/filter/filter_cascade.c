@@ -0,0 +1,127 @@
+/*
+ * filter_cascade.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "filter_cascade.h"
+#include "filter_model.h"
+
+#include <math.h>
+#include <string.h>
+
+// tau = 10, 100, 1000 s
+static const uint32_t cascade_len[FILTER_CASCADE_STAGES] = { 10, 100, 1000 };
+
+#define CASCADE_OUT_N  (KF_N < 3 ? KF_N : 3)
+
+typedef struct {
+	uint32_t count;             // samples in the open block
+	int64_t phase_ref;          // phase base at the block start
+	double sum[KF_N];           // sum of x, phase relative to phase_ref
+	float S[KF_N * KF_N];       // sum_i E[e_k e_i^T] over the block
+	float T[KF_NS];             // sum_ij E[e_i e_j^T], packed
+	filter_cascade_out_t out;
+} cascade_stage_t;
+
+static const float F_data[KF_N * KF_N] = KF_MATRIX(KF_F);
+
+static cascade_stage_t stages[FILTER_CASCADE_STAGES];
+
+void cascade_reset(void) {
+	memset(stages, 0, sizeof(stages));
+	for (int s = 0; s < FILTER_CASCADE_STAGES; s++)
+		stages[s].out.tau_s = cascade_len[s];
+}
+
+/*
+ * The error of the posterior runs e_k = A_k e_(k-1) + noise with
+ * A_k = (I - K_k H) Phi_k, so E[e_k e_i^T] = A_k E[e_(k-1) e_i^T] for i < k:
+ *   S_k = P_k + A_k S_(k-1)
+ *   T_k = T_(k-1) + S_k + S_k^T - P_k
+ * and the block mean of n samples has the covariance T_n / n^2. Averaging
+ * the filter output as if its errors were independent (P / n) would claim
+ * far too much at the long taus, where the errors are strongly correlated.
+ */
+static void cascade_propagate(cascade_stage_t *st, const float *P,
+		const float *K, float dT) {
+	float M[KF_N * KF_N];
+
+	// M = Phi S, Phi = G F (G = I without temperature input)
+	for (int i = 0; i < KF_N; i++)
+		for (int j = 0; j < KF_N; j++) {
+			float s = st->S[i * KF_N + j];
+			for (int k = i + 1; k < KF_N; k++)
+				s += F_data[i * KF_N + k] * st->S[k * KF_N + j];
+			M[i * KF_N + j] = s;
+		}
+#if KF_N == 4
+	const float u0 = 0.5f * KF_R * FILTER_T * dT;
+	for (int j = 0; j < KF_N; j++) {
+		M[KF_PHASE * KF_N + j] += u0 * M[KF_TEMPCO * KF_N + j];
+		M[KF_FREQ * KF_N + j] += dT * M[KF_TEMPCO * KF_N + j];
+	}
+#else
+	(void) dT;
+#endif
+
+	// S = P + (I - K H) M, H = [1 0 ..]
+	for (int i = 0; i < KF_N; i++)
+		for (int j = 0; j < KF_N; j++) {
+			const float p = i <= j ? P[KF_IDX(i, j)] : P[KF_IDX(j, i)];
+			st->S[i * KF_N + j] = p + M[i * KF_N + j] - K[i] * M[j];
+		}
+
+	for (int i = 0; i < KF_N; i++)
+		for (int j = i; j < KF_N; j++)
+			st->T[KF_IDX(i, j)] += st->S[i * KF_N + j] + st->S[j * KF_N + i]
+					- P[KF_IDX(i, j)];
+}
+
+static void cascade_close(cascade_stage_t *st, uint32_t iteration) {
+	const double n = (double) st->count;
+
+	for (int i = 0; i < CASCADE_OUT_N; i++) {
+		st->out.x[i] = (float) (st->sum[i] / n);
+		st->out.sigma[i] = sqrtf(fmaxf(st->T[KF_IDX(i, i)], 0.0f)) / (float) n;
+	}
+	st->out.x[KF_PHASE] += (float) st->phase_ref;
+	st->out.iteration = iteration;
+	st->out.blocks++;
+	st->count = 0;
+}
+
+void cascade_record(const float *x, const float *P, const float *K,
+		int64_t phase_base, float dT, uint32_t iteration) {
+	for (int s = 0; s < FILTER_CASCADE_STAGES; s++) {
+		cascade_stage_t *st = &stages[s];
+
+		if (st->count == 0) {
+			st->phase_ref = phase_base;
+			memset(st->sum, 0, sizeof(st->sum));
+			for (int i = 0; i < KF_N; i++)
+				for (int j = 0; j < KF_N; j++)
+					st->S[i * KF_N + j] = i <= j ? P[KF_IDX(i, j)]
+							: P[KF_IDX(j, i)];
+			memcpy(st->T, P, sizeof(st->T));
+		} else {
+			cascade_propagate(st, P, K, dT);
+		}
+
+		st->sum[KF_PHASE] += (double) (phase_base - st->phase_ref)
+				+ x[KF_PHASE];
+		for (int i = 1; i < KF_N; i++)
+			st->sum[i] += x[i];
+
+		if (++st->count == cascade_len[s])
+			cascade_close(st, iteration);
+	}
+}
+
+bool cascade_get(uint8_t stage, filter_cascade_out_t *dst) {
+	if (stage >= FILTER_CASCADE_STAGES || stages[stage].out.blocks == 0)
+		return false;
+
+	*dst = stages[stage].out;
+	return true;
+}
@@ -0,0 +1,40 @@
+/*
+ * filter_cascade.h
+ *
+ *  Multi-rate cascade behind the 1 s Kalman filter. Stage n averages the
+ *  filter state over blocks of tau = 10^(n+1) s (10, 100 and 1000 s) and
+ *  propagates the covariance of the block mean, including the correlation
+ *  of the filter errors from one second to the next.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef FILTER_FILTER_CASCADE_H_
+#define FILTER_FILTER_CASCADE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define FILTER_CASCADE_STAGES  3
+
+typedef struct {
+	uint32_t tau_s;         // block length
+	uint32_t blocks;        // blocks completed since reset
+	uint32_t iteration;     // filter iteration that closed the block
+	float x[3];             // block mean of phase, frequency, drift
+	float sigma[3];         // their standard deviations
+} filter_cascade_out_t;
+
+void cascade_reset(void);
+
+// Called by filter.c after every correction with the posterior, the gain
+// applied (zero for a rejected sample) and the temperature input dT of
+// the 4-state model.
+void cascade_record(const float *x, const float *P, const float *K,
+		int64_t phase_base, float dT, uint32_t iteration);
+
+// Latest completed block of a stage; false until the first one. The means
+// describe the middle of the block, tau / 2 before it closed.
+bool cascade_get(uint8_t stage, filter_cascade_out_t *dst);
+
+#endif /* FILTER_FILTER_CASCADE_H_ */
@@ -0,0 +1,132 @@
+/*
+ * filter_model.h
+ *
+ *  Compile-time model of the Kalman filter family. FILTER_STATES selects
+ *  2 (phase, frequency), 3 (+ drift) or 4 (+ frequency temperature
+ *  coefficient) states; F, F^T, the shape of Q and the initial P are
+ *  constant tables built from the sample interval, so every matrix size is
+ *  static and the kernels in filter.c unroll completely.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef FILTER_FILTER_MODEL_H_
+#define FILTER_FILTER_MODEL_H_
+
+#include "filter.h"
+#include "gpsdo_config.h"
+
+#define FILTER_T    1.0f        // sample interval (s)
+
+// counts per oscillator cycle over FILTER_T
+#define KF_R        ((float) EXPECTED_CTR / ((float) F_OSC_HZ * FILTER_T))
+
+#define KF_N        FILTER_STATES
+#define KF_NS       (KF_N * (KF_N + 1) / 2)     // packed upper triangle
+
+// State indices. Phase, frequency and drift form an integrator chain; the
+// temperature coefficient of the 4-state model is a random walk beside it.
+#define KF_PHASE    0
+#define KF_FREQ     1
+#define KF_DRIFT    2           // KF_N >= 3
+#define KF_TEMPCO   3           // KF_N == 4
+
+#if KF_N == 4
+#define KF_CHAIN    3
+#else
+#define KF_CHAIN    KF_N
+#endif
+
+// The 4-state model takes the temperature step dT as a known input:
+// F(:, TEMPCO) = (r T dT / 2, dT, 0, 1), applied as F = G F_chain with
+// G = I + u e3^T, so F_chain stays constant. F then changes every step and
+// there is no constant (steady state) gain.
+#define KF_TIME_INVARIANT   (KF_N < 4)
+
+// Fully unrolls a kernel loop; the compiler gives up on the nested 4-state
+// loops by itself and then looks F up at run time
+#define KF_UNROLL   _Pragma("GCC unroll 16")
+
+// Upper triangle index of (i, j), i <= j
+#define KF_IDX(i, j)    ((i) * (2 * KF_N - (i) + 1) / 2 + (j) - (i))
+
+// T^n and n! for the small powers the tables need
+#define KF_POW_T(n)     ((n) == 0 ? 1.0f : (n) == 1 ? FILTER_T \
+		: (n) == 2 ? FILTER_T * FILTER_T \
+		: (n) == 3 ? FILTER_T * FILTER_T * FILTER_T \
+		: (n) == 4 ? FILTER_T * FILTER_T * FILTER_T * FILTER_T \
+		: FILTER_T * FILTER_T * FILTER_T * FILTER_T * FILTER_T)
+#define KF_FACT(n)      ((n) <= 1 ? 1.0f : (n) == 2 ? 2.0f : 6.0f)
+
+#define KF_IN_CHAIN(i, j)   ((i) < KF_CHAIN && (j) < KF_CHAIN)
+
+// F: T^(j-i) / (j-i)! along the chain, the phase row in counts (x r)
+#define KF_F(i, j) \
+	(!KF_IN_CHAIN(i, j) ? ((i) == (j) ? 1.0f : 0.0f) \
+	: (j) < (i) ? 0.0f \
+	: KF_POW_T((j) - (i)) / KF_FACT((j) - (i)) \
+			* ((i) == 0 && (j) > 0 ? KF_R : 1.0f))
+#define KF_FT(i, j)     KF_F(j, i)
+
+// Q / q: white noise on the last derivative of the chain, integrated
+// T^(2m-1-i-j) / ((m-1-i)! (m-1-j)! (2m-1-i-j)), m = KF_CHAIN
+#define KF_QE(i, j)     (2 * KF_CHAIN - 1 - (i) - (j))
+#define KF_QU(i, j) \
+	(!KF_IN_CHAIN(i, j) ? 0.0f \
+	: KF_POW_T(KF_QE(i, j)) / (KF_FACT(KF_CHAIN - 1 - (i)) \
+			* KF_FACT(KF_CHAIN - 1 - (j)) * (float) KF_QE(i, j)))
+
+// Default q: the white noise density on the chain's last derivative,
+// frequency for the 2-state model, drift otherwise. Without a drift state
+// the frequency walk has to absorb the ageing, hence the larger value.
+#if KF_CHAIN == 2
+#define KF_Q_DEFAULT    1e-4f
+#else
+#define KF_Q_DEFAULT    1e-7f
+#endif
+
+// Temperature coefficient random walk ((Hz/°C)^2 per s), not scaled by q
+#define KF_Q_TEMPCO     1e-14f
+
+// NTC steps larger than this per sample are sensor glitches, not input
+#define KF_TEMP_STEP_MAX    1.0f   // °C
+
+#define KF_EYE(i, j)    ((i) == (j) ? 1.0f : 0.0f)
+
+// Control input B (per volt): an EFC step dv moves the oscillator by
+// Ku_HzDV dv, i.e. the count of every following interval by KF_R T Ku_HzDV dv.
+// The measurement is that per interval count, so the step lands on the
+// phase state alone; putting Ku_HzDV on the frequency state as well would
+// integrate it into a ramp (gpsdo_sim --efc-step, README "Control input").
+#define KF_B(i)         ((i) == KF_PHASE ? KF_R * FILTER_T * Ku_HzDV : 0.0f)
+
+// Initial covariance: ±0.2 cycles, ±2 Hz, ±0.02 Hz/s, ±0.01 Hz/°C
+#define KF_P0_DIAG(i)   ((i) == 0 ? 0.20f * 0.20f : (i) == 1 ? 2.0f * 2.0f \
+		: (i) == 2 ? 0.02f * 0.02f : 0.01f * 0.01f)
+#define KF_P0(i, j)     ((i) == (j) ? KF_P0_DIAG(i) : 0.0f)
+
+// N vector initializer of M(i), row-major N x N initializer of M(i, j)
+#define KF_ROW_2(M, i)  M(i, 0), M(i, 1)
+#define KF_ROW_3(M, i)  KF_ROW_2(M, i), M(i, 2)
+#define KF_ROW_4(M, i)  KF_ROW_3(M, i), M(i, 3)
+
+#if KF_N == 2
+#define KF_VECTOR(M)    { M(0), M(1) }
+#define KF_MATRIX(M)    { KF_ROW_2(M, 0), KF_ROW_2(M, 1) }
+#define KF_UPPER(M)     { M(0, 0), M(0, 1), M(1, 1) }
+#elif KF_N == 3
+#define KF_VECTOR(M)    { M(0), M(1), M(2) }
+#define KF_MATRIX(M)    { KF_ROW_3(M, 0), KF_ROW_3(M, 1), KF_ROW_3(M, 2) }
+#define KF_UPPER(M)     { M(0, 0), M(0, 1), M(0, 2), M(1, 1), M(1, 2), \
+		M(2, 2) }
+#elif KF_N == 4
+#define KF_VECTOR(M)    { M(0), M(1), M(2), M(3) }
+#define KF_MATRIX(M)    { KF_ROW_4(M, 0), KF_ROW_4(M, 1), KF_ROW_4(M, 2), \
+		KF_ROW_4(M, 3) }
+#define KF_UPPER(M)     { M(0, 0), M(0, 1), M(0, 2), M(0, 3), M(1, 1), \
+		M(1, 2), M(1, 3), M(2, 2), M(2, 3), M(3, 3) }
+#else
+#error "FILTER_STATES must be 2, 3 or 4"
+#endif
+
+#endif /* FILTER_FILTER_MODEL_H_ */
@@ -0,0 +1,264 @@
+/*
+ * filter_smoother.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "filter_smoother.h"
+#include "filter_model.h"
+#include "hal.h"
+
+#include <math.h>
+#include <string.h>
+
+// One filter step: prior (after the phase rebase of filter_predict) and
+// posterior, both against the same phase_base
+typedef struct {
+	int64_t phase_base;
+	uint32_t iteration;
+	float x_pred[KF_N];
+	float P_pred[KF_NS];    // packed upper triangle (KF_IDX)
+	float x[KF_N];
+	float P[KF_NS];
+#if KF_N == 4
+	float dT;               // temperature input into this step
+#endif
+} smoother_record_t;
+
+// Two spare slots: the record being written and one step the filter may
+// complete while a pass runs
+#define SMOOTH_RING    (FILTER_SMOOTH_LAG + 3)
+
+// phase, frequency and drift in the telemetry
+#define SMOOTH_OUT_N   (KF_N < 3 ? KF_N : 3)
+
+static const float F_data[KF_N * KF_N] = KF_MATRIX(KF_F);
+
+static smoother_record_t ring[SMOOTH_RING];
+static uint32_t ring_head = 0;              // records committed since reset
+
+static KF_SmoothSnapshot mailbox;
+static bool mailbox_full = false;
+
+// Backward pass working set, static so the manager task stack only holds
+// the call frames (~1 KB of doubles at KF_N = 4). smoother_run() has the
+// one caller, smoother_update() on tsk_manager.
+static struct {
+	double xs[KF_N], Ps[KF_N * KF_N];
+	double Pk[KF_N * KF_N], Pp[KF_N * KF_N], A[KF_N * KF_N];
+	double Ct[KF_N * KF_N], E[KF_N * KF_N], d[KF_N];
+	double L[KF_N * KF_N], y[KF_N];
+} pass;
+
+void smoother_reset(void) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	ring_head = 0;
+	mailbox_full = false;
+
+	__set_PRIMASK(primask);
+}
+
+void smoother_record_prior(const float *x_pred, const float *P_pred, float dT) {
+	smoother_record_t *r = &ring[ring_head % SMOOTH_RING];
+
+	memcpy(r->x_pred, x_pred, sizeof(r->x_pred));
+	memcpy(r->P_pred, P_pred, sizeof(r->P_pred));
+#if KF_N == 4
+	r->dT = dT;
+#else
+	(void) dT;
+#endif
+}
+
+void smoother_record_posterior(const float *x, const float *P,
+		int64_t phase_base, uint32_t iteration) {
+	smoother_record_t *r = &ring[ring_head % SMOOTH_RING];
+
+	memcpy(r->x, x, sizeof(r->x));
+	memcpy(r->P, P, sizeof(r->P));
+	r->phase_base = phase_base;
+	r->iteration = iteration;
+
+	// publish after the record is complete
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	ring_head++;
+	__set_PRIMASK(primask);
+}
+
+static uint32_t smoother_head(void) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	uint32_t head = ring_head;
+	__set_PRIMASK(primask);
+	return head;
+}
+
+static void smoother_unpack(const float *Ps, double *M) {
+	for (int i = 0; i < KF_N; i++)
+		for (int j = i; j < KF_N; j++)
+			M[i * KF_N + j] = M[j * KF_N + i] = Ps[KF_IDX(i, j)];
+}
+
+// A = Phi M with Phi = G F of the step (G = I without temperature input)
+static void smoother_transition(const smoother_record_t *r, const double *M,
+		double *A) {
+	for (int i = 0; i < KF_N; i++)
+		for (int j = 0; j < KF_N; j++) {
+			double s = 0.0;
+			for (int k = 0; k < KF_N; k++)
+				s += (double) F_data[i * KF_N + k] * M[k * KF_N + j];
+			A[i * KF_N + j] = s;
+		}
+#if KF_N == 4
+	const double u0 = 0.5 * KF_R * FILTER_T * r->dT;
+	for (int j = 0; j < KF_N; j++) {
+		A[KF_PHASE * KF_N + j] += u0 * A[KF_TEMPCO * KF_N + j];
+		A[KF_FREQ * KF_N + j] += r->dT * A[KF_TEMPCO * KF_N + j];
+	}
+#else
+	(void) r;
+#endif
+}
+
+// Solves P X = B for symmetric positive definite P (Cholesky), B N x N
+static bool smoother_solve(const double *P, const double *B, double *X) {
+	double *L = pass.L, *y = pass.y;
+	memset(pass.L, 0, sizeof(pass.L));
+
+	for (int j = 0; j < KF_N; j++) {
+		double d = P[j * KF_N + j];
+		for (int k = 0; k < j; k++)
+			d -= L[j * KF_N + k] * L[j * KF_N + k];
+		if (!(d > 0.0))
+			return false;
+		L[j * KF_N + j] = sqrt(d);
+		for (int i = j + 1; i < KF_N; i++) {
+			double s = P[i * KF_N + j];
+			for (int k = 0; k < j; k++)
+				s -= L[i * KF_N + k] * L[j * KF_N + k];
+			L[i * KF_N + j] = s / L[j * KF_N + j];
+		}
+	}
+
+	for (int c = 0; c < KF_N; c++) {
+		for (int i = 0; i < KF_N; i++) {
+			double s = B[i * KF_N + c];
+			for (int k = 0; k < i; k++)
+				s -= L[i * KF_N + k] * y[k];
+			y[i] = s / L[i * KF_N + i];
+		}
+		for (int i = KF_N - 1; i >= 0; i--) {
+			double s = y[i];
+			for (int k = i + 1; k < KF_N; k++)
+				s -= L[k * KF_N + i] * X[k * KF_N + c];
+			X[i * KF_N + c] = s / L[i * KF_N + i];
+		}
+	}
+	return true;
+}
+
+/*
+ * RTS, from the newest posterior back:
+ *   C_k   = P_k Phi^T P-_{k+1}^-1
+ *   xs_k  = x_k + C_k (xs_{k+1} - x-_{k+1})
+ *   Ps_k  = P_k + C_k (Ps_{k+1} - P-_{k+1}) C_k^T
+ * In double: P- spans the 0.1 cycle^2 phase and the tiny drift variance.
+ * Every record keeps its prior and posterior against one phase base, so
+ * the differences stay consistent across filter rebases.
+ */
+bool smoother_run(KF_SmoothSnapshot *dst) {
+	const uint32_t head = smoother_head();
+	if (head < FILTER_SMOOTH_LAG + 1)
+		return false;
+
+	const smoother_record_t *r = &ring[(head - 1) % SMOOTH_RING];
+	double *xs = pass.xs, *Ps = pass.Ps;
+	double *Pk = pass.Pk, *Pp = pass.Pp, *A = pass.A;
+	double *Ct = pass.Ct, *E = pass.E, *d = pass.d;
+	for (int i = 0; i < KF_N; i++)
+		xs[i] = r->x[i];
+	smoother_unpack(r->P, Ps);
+
+	for (uint32_t n = 1; n <= FILTER_SMOOTH_LAG; n++) {
+		const smoother_record_t *next = r;
+		r = &ring[(head - 1 - n) % SMOOTH_RING];
+
+		smoother_unpack(r->P, Pk);
+		smoother_unpack(next->P_pred, Pp);
+		smoother_transition(next, Pk, A);       // Phi P_k = P-_{k+1} C^T
+		if (!smoother_solve(Pp, A, Ct))
+			return false;
+
+		for (int i = 0; i < KF_N; i++)
+			d[i] = xs[i] - next->x_pred[i];
+		for (int i = 0; i < KF_N; i++) {
+			double s = r->x[i];
+			for (int m = 0; m < KF_N; m++)
+				s += Ct[m * KF_N + i] * d[m];
+			xs[i] = s;
+		}
+
+		// E = (Ps - P-) C^T, Ps = P_k + C E
+		for (int i = 0; i < KF_N; i++)
+			for (int j = 0; j < KF_N; j++) {
+				double s = 0.0;
+				for (int m = 0; m < KF_N; m++)
+					s += (Ps[i * KF_N + m] - Pp[i * KF_N + m]) * Ct[m * KF_N + j];
+				E[i * KF_N + j] = s;
+			}
+		for (int i = 0; i < KF_N; i++)
+			for (int j = 0; j < KF_N; j++) {
+				double s = Pk[i * KF_N + j];
+				for (int m = 0; m < KF_N; m++)
+					s += Ct[m * KF_N + i] * E[m * KF_N + j];
+				Ps[i * KF_N + j] = s;
+			}
+	}
+
+	// the filter may have completed one step meanwhile, not two
+	if (smoother_head() - head > 1)
+		return false;
+
+	memset(dst, 0, sizeof(*dst));
+	dst->iteration = r->iteration;
+	dst->lag = FILTER_SMOOTH_LAG;
+	for (int i = 0; i < SMOOTH_OUT_N; i++) {
+		dst->x[i] = (float) xs[i];
+		dst->sigma[i] = (float) sqrt(fmax(Ps[i * KF_N + i], 0.0));
+		dst->x_filt[i] = r->x[i];
+	}
+	dst->x[0] += (float) r->phase_base;
+	dst->x_filt[0] += (float) r->phase_base;
+	return true;
+}
+
+void smoother_update(void) {
+	KF_SmoothSnapshot result;
+
+	if (mailbox_full || !smoother_run(&result))
+		return;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	mailbox = result;
+	mailbox_full = true;
+	__set_PRIMASK(primask);
+}
+
+bool smoother_take(KF_SmoothSnapshot *dst) {
+	bool taken = false;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	if (mailbox_full) {
+		*dst = mailbox;
+		mailbox_full = false;
+		taken = true;
+	}
+	__set_PRIMASK(primask);
+
+	return taken;
+}
@@ -0,0 +1,44 @@
+/*
+ * filter_smoother.h
+ *
+ *  Fixed-lag Rauch-Tung-Striebel smoother. filter.c records the prior and
+ *  posterior of every step in a ring buffer; a backward pass over the last
+ *  FILTER_SMOOTH_LAG steps, run at low priority, gives the state of the
+ *  sample FILTER_SMOOTH_LAG seconds back conditioned on every sample since.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef FILTER_FILTER_SMOOTHER_H_
+#define FILTER_FILTER_SMOOTHER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "flatbuf_defs.h"
+
+// Samples the smoothed estimate trails the filter by. Build flag: the ring
+// holds FILTER_SMOOTH_LAG + 3 records of 88 bytes for the 3-state model
+// (128 for the 4-state one), 5.4 KB at the default.
+#ifndef FILTER_SMOOTH_LAG
+#define FILTER_SMOOTH_LAG 60
+#endif
+
+void smoother_reset(void);
+
+// Called by filter.c: the prior at the end of filter_predict(), then the
+// posterior at the end of filter_correct(), which commits the record.
+// dT is the temperature input of the 4-state model, 0 otherwise.
+void smoother_record_prior(const float *x_pred, const float *P_pred, float dT);
+void smoother_record_posterior(const float *x, const float *P,
+		int64_t phase_base, uint32_t iteration);
+
+// Backward pass over the newest FILTER_SMOOTH_LAG steps; false until that
+// much history exists or if the filter overwrote it during the pass
+bool smoother_run(KF_SmoothSnapshot *dst);
+
+// Low priority task: runs a pass into the mailbox once the last result was
+// taken. The filter task takes the result for telemetry.
+void smoother_update(void);
+bool smoother_take(KF_SmoothSnapshot *dst);
+
+#endif /* FILTER_FILTER_SMOOTHER_H_ */
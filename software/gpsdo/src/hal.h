@@ -27,6 +27,6 @@ extern USBD_HandleTypeDef hUsbDeviceFS;
 
 extern SPI_HandleTypeDef hspi1;
 
-extern osSemaphoreId_t xPPSSemaphoreHandle;
+extern osThreadId_t tsk_controllerHandle;
 
 #endif /* HAL_H_ */
@@ -9,20 +9,49 @@
 #include "hal.h"
 #include "usb.h"
 #include "led.h"
+#include "profile.h"
+#include "gpsdo_config.h"
 
-#include <semphr.h>
+/*
+ * Single producer (the TIM5 ISR), single consumer (controllerTask) ring of
+ * capture records. Each side writes only its own free running index, so
+ * neither needs a lock; a full ring drops the new record, which the
+ * consumer sees as a missed pulse in the count interval.
+ */
+static pps_capture_t ring[PPS_RING_SIZE];
+static volatile uint32_t ring_head = 0;        // written by the ISR only
+static volatile uint32_t ring_tail = 0;        // by controllerTask only
 
-static volatile uint32_t last_PPS = 0;
-static volatile uint32_t PPS_delta = 0;
+static volatile uint32_t pps_seq = 0;
+static volatile uint32_t pps_overruns = 0;
+static volatile uint32_t pps_backlog_max = 0;
+static volatile uint32_t pps_sw_reads = 0;     // edges without a TIM1 latch
+
+// consumer side
+static uint32_t last_count = 0;
+static bool have_last = false;
 
 void pps_init() {
+	ring_head = 0;
+	ring_tail = 0;
+	pps_seq = 0;
+	pps_overruns = 0;
+	pps_backlog_max = 0;
+	pps_sw_reads = 0;
+	have_last = false;
+
 	HAL_TIM_Base_Start(&htim2);   // start high word first
 	HAL_TIM_Base_Start(&htim1);   // then low word (counts 5MHz)
 
+#if PPS_LATCH
+	// TIM1 CH3 (PA10) latches the low word on the PPS edge, no interrupt
+	HAL_TIM_IC_Start(&htim1, TIM_CHANNEL_3);
+#endif
 	HAL_TIM_IC_Start_IT(&htim5, TIM_CHANNEL_1);
 }
 
-static uint32_t ReadCount(void) {
+// tick: TIM5 at the read, against the PPS edge in its CCR1
+static uint32_t ReadCount(uint32_t *tick) {
 	uint16_t low;
 	uint32_t high;
 
@@ -30,23 +59,122 @@ static uint32_t ReadCount(void) {
 	do {
 		high = TIM2->CNT;
 		low = TIM1->CNT;
+		*tick = TIM5->CNT;
 	} while (high != TIM2->CNT);
 
 	return (high << 16) | low;
 }
 
+// Count at the PPS edge: the software read, less the counts of its
+// latency TIM5 measured, to the nearest count. With PPS_LATCH TIM1 also
+// latched its low word on the edge, and the read supplies the high word.
+// It trails the edge by the interrupt latency, far less than the 13 ms
+// the low word takes to wrap, so the counts between the two are
+// (uint16_t) (now - latched). A latch further than PPS_LATCH_MARGIN from
+// the measured latency is a noise edge on PA10, not the PPS.
+static uint32_t CaptureCount(uint32_t edge_tick, uint32_t *flags) {
+	uint32_t tick;
+	uint32_t now = ReadCount(&tick);
+
+	// TIM5 runs at the core clock (APB1 at HCLK / 2, timer clock doubled)
+	const uint32_t latency = tick - edge_tick;
+	profile_record(PROFILE_PPS_READ_LATENCY, latency);
+	const uint32_t latency_counts = (uint32_t) ((float) latency
+			* EXPECTED_CTR / (float) SystemCoreClock + 0.5f);
+
+	*flags = 0;
+#if PPS_LATCH
+	const uint32_t sr = TIM1->SR;
+	if (sr & TIM_SR_CC3IF) {
+		uint16_t latched = (uint16_t) TIM1->CCR3;   // clears CC3IF
+		TIM1->SR = ~(uint32_t) TIM_SR_CC3OF;        // glitch edge in between
+
+		const uint16_t since = (uint16_t) ((uint16_t) now - latched);
+		const int32_t off = (int32_t) since - (int32_t) latency_counts;
+		if (off >= -PPS_LATCH_MARGIN && off <= PPS_LATCH_MARGIN) {
+			*flags = PPS_CAPTURE_LATCHED
+					| ((sr & TIM_SR_CC3OF) ? PPS_CAPTURE_OVERCAPTURE : 0);
+			return now - since;
+		}
+		*flags = PPS_CAPTURE_LATCH_BAD;
+	}
+#endif
+
+	pps_sw_reads++;
+	return now - latency_counts;
+}
+
+static void pps_push(const pps_capture_t *c) {
+	const uint32_t head = ring_head;
+	const uint32_t backlog = head - ring_tail;
+
+	if (backlog >= PPS_RING_SIZE) {
+		pps_overruns++;
+		return;
+	}
+
+	ring[head & (PPS_RING_SIZE - 1)] = *c;
+	__DMB();                    // the record before the index publishing it
+	ring_head = head + 1;
+
+	if (backlog + 1 > pps_backlog_max)
+		pps_backlog_max = backlog + 1;
+}
+
 void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim) {
 	if (htim->Instance == TIM5) {
-		uint32_t now = ReadCount();
+		uint32_t entry = TIM5->CNT;
+		uint32_t t0 = profile_start();
+		pps_capture_t c;
 
-		if (last_PPS != 0) {
-			PPS_delta = now - last_PPS;
-			osSemaphoreRelease(xPPSSemaphoreHandle);
-		}
-		last_PPS = now;
+		c.tick = TIM5->CCR1;
+		profile_record(PROFILE_PPS_IRQ_LATENCY, entry - c.tick);
+
+		c.count = CaptureCount(c.tick, &c.flags);
+		c.seq = pps_seq++;
+		pps_push(&c);
+		osThreadFlagsSet(tsk_controllerHandle, PPS_THREAD_FLAG);
+
+		profile_stop(PROFILE_PPS_ISR, t0);
+	}
+}
+
+bool pps_pop(pps_capture_t *dst) {
+	const uint32_t tail = ring_tail;
+
+	if (ring_head == tail)
+		return false;
+
+	__DMB();                    // the index before the record it published
+	*dst = ring[tail & (PPS_RING_SIZE - 1)];
+	__DMB();                    // the record before handing the slot back
+	ring_tail = tail + 1;
+	return true;
+}
+
+bool pps_get_delta(uint32_t *delta) {
+	pps_capture_t c;
+
+	while (pps_pop(&c)) {
+		const bool first = !have_last;
+
+		*delta = c.count - last_count;
+		last_count = c.count;
+		have_last = true;
+		if (!first)
+			return true;
 	}
+	return false;
 }
 
-uint32_t pps_get_delta() {
-	return PPS_delta;
+void pps_get_stats(pps_stats_t *dst) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	dst->seq = pps_seq;
+	dst->overruns = pps_overruns;
+	dst->backlog_max = pps_backlog_max;
+	dst->sw_reads = pps_sw_reads;
+
+	__set_PRIMASK(primask);
 }
@@ -8,9 +8,54 @@
 #ifndef PPS_PPS_H_
 #define PPS_PPS_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
+// Capture records between the TIM5 ISR and controllerTask (power of two)
+#define PPS_RING_SIZE  16
+
+// osThreadFlagsSet() on tsk_controller for every captured edge
+#define PPS_THREAD_FLAG  0x0001U
+
+// TIM1 CH3 (PA10) latches the OCXO count on the PPS edge. PA10 is not
+// connected on the current PCB; build with PPS_LATCH=1 once it is.
+#ifndef PPS_LATCH
+#define PPS_LATCH  0
+#endif
+
+// counts a latched edge may lie off the TIM5 measured read latency
+#define PPS_LATCH_MARGIN  2
+
+#define PPS_CAPTURE_LATCHED      (1U << 0)   // count latched by TIM1 CH3
+#define PPS_CAPTURE_OVERCAPTURE  (1U << 1)   // another PA10 edge since
+                                             // the last capture
+#define PPS_CAPTURE_LATCH_BAD    (1U << 2)   // latch off the measured
+                                             // latency, software read used
+
+typedef struct {
+	uint32_t count;     // OCXO count at the edge
+	uint32_t tick;      // TIM5 capture of the edge, core clock
+	uint32_t seq;       // edge number since pps_init(), gaps are overruns
+	uint32_t flags;     // PPS_CAPTURE_*
+} pps_capture_t;
+
+typedef struct {
+	uint32_t seq;           // edges captured
+	uint32_t overruns;      // of them dropped on a full ring
+	uint32_t backlog_max;   // most records waiting for controllerTask
+	uint32_t sw_reads;      // counted by the software read, no usable
+	                        // TIM1 latch
+} pps_stats_t;
+
 void pps_init();
-uint32_t pps_get_delta();
+
+// Consumer side, controllerTask only. pps_pop() takes the oldest record;
+// pps_get_delta() the count interval ending at it, skipping the first
+// edge after pps_init() that only starts the count. Both return false
+// once the ring is empty.
+bool pps_pop(pps_capture_t *dst);
+bool pps_get_delta(uint32_t *delta);
+
+void pps_get_stats(pps_stats_t *dst);
 
 #endif /* PPS_PPS_H_ */
@@ -0,0 +1,69 @@
+/*
+ * profile.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "profile.h"
+
+#include <string.h>
+
+static profile_stats_t profile_stats[PROFILE_SECTION_COUNT];
+
+void profile_init(void) {
+	// enable trace and the free running cycle counter
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	profile_reset();
+}
+
+void profile_reset(void) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	memset(profile_stats, 0, sizeof(profile_stats));
+	for (int i = 0; i < PROFILE_SECTION_COUNT; i++)
+		profile_stats[i].min = UINT32_MAX;
+
+	__set_PRIMASK(primask);
+}
+
+void profile_stop(profile_section_t section, uint32_t start) {
+	// unsigned difference is wrap safe up to 2^32 cycles (~44 s at 96 MHz)
+	profile_record(section, DWT->CYCCNT - start);
+}
+
+void profile_record(profile_section_t section, uint32_t cycles) {
+	uint32_t bucket = (cycles == 0) ? 0 : 31 - __CLZ(cycles);
+
+	// sections run from the TIM5 ISR as well as from tasks
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	profile_stats_t *s = &profile_stats[section];
+	s->count++;
+	s->last = cycles;
+	s->sum += cycles;
+	if (cycles < s->min)
+		s->min = cycles;
+	if (cycles > s->max)
+		s->max = cycles;
+	s->hist[bucket]++;
+
+	__set_PRIMASK(primask);
+}
+
+void profile_get(profile_section_t section, profile_stats_t *dst) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	*dst = profile_stats[section];
+
+	__set_PRIMASK(primask);
+}
+
+uint32_t profile_cpu_hz(void) {
+	return SystemCoreClock;
+}
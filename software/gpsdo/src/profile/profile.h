@@ -0,0 +1,57 @@
+/*
+ * profile.h
+ *
+ *  Cycle profiler for the hot paths of the PPS -> filter -> DAC -> USB chain.
+ *  Sections are timed with the DWT cycle counter and accumulated into
+ *  min/max/mean and a log2 histogram, streamed as Profile telemetry.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef PROFILE_PROFILE_H_
+#define PROFILE_PROFILE_H_
+
+#include <stdint.h>
+#include "hal.h"
+
+typedef enum {
+	PROFILE_PPS_ISR = 0,
+	PROFILE_FILTER_STEP,
+	PROFILE_CONTROL,
+	PROFILE_DAC_SET_VOLTAGE,
+	PROFILE_SEND_STATUS,
+	PROFILE_SEND_KF_DEBUG,
+	PROFILE_USB_TX,
+	PROFILE_PPS_IRQ_LATENCY,    // PPS edge to the capture callback
+	PROFILE_PPS_READ_LATENCY,   // PPS edge to the counter read
+	PROFILE_SECTION_COUNT
+} profile_section_t;
+
+// bucket i counts durations in [2^i, 2^(i+1)) cycles, bucket 0 also holds 0
+#define PROFILE_HIST_BUCKETS 32
+
+typedef struct {
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint32_t last;
+	uint64_t sum;
+	uint32_t hist[PROFILE_HIST_BUCKETS];
+} profile_stats_t;
+
+void profile_init(void);
+void profile_reset(void);
+
+static inline uint32_t profile_start(void) {
+	return DWT->CYCCNT;
+}
+
+void profile_stop(profile_section_t section, uint32_t start);
+
+// Adds a duration timed by other means, in core clock cycles
+void profile_record(profile_section_t section, uint32_t cycles);
+
+void profile_get(profile_section_t section, profile_stats_t *dst);
+uint32_t profile_cpu_hz(void);
+
+#endif /* PROFILE_PROFILE_H_ */
@@ -0,0 +1,52 @@
+/*
+ * bench_alloc.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "bench_alloc.h"
+
+uint64_t bench_heap_allocs = 0;
+uint64_t bench_arena_allocs = 0;
+
+#ifdef BENCH_WRAP_MALLOC
+// only calls from objects linked with -Wl,--wrap=... are seen here
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+	bench_heap_allocs++;
+	return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size) {
+	bench_heap_allocs++;
+	return __real_calloc(nmemb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+	bench_heap_allocs++;
+	return __real_realloc(ptr, size);
+}
+#endif
+
+#ifdef BENCH_FLATCC
+void *flatcc_portable_malloc(size_t size);
+void *flatcc_portable_realloc(void *ptr, size_t size);
+void flatcc_portable_free(void *ptr);
+
+void *bench_flatcc_malloc(size_t size) {
+	bench_arena_allocs++;
+	return flatcc_portable_malloc(size);
+}
+
+void *bench_flatcc_realloc(void *ptr, size_t size) {
+	bench_arena_allocs++;
+	return flatcc_portable_realloc(ptr, size);
+}
+
+void bench_flatcc_free(void *ptr) {
+	flatcc_portable_free(ptr);
+}
+#endif
@@ -0,0 +1,26 @@
+/*
+ * bench_alloc.h
+ *
+ *  Allocation counters for gpsdo_bench. Heap allocations made by the
+ *  firmware objects are counted through the linker's --wrap of
+ *  malloc/calloc/realloc; FlatCC allocations are routed through
+ *  bench_flatcc_*() into the firmware arena (flatbuf_flatcc_alloc.c).
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef BENCH_BENCH_ALLOC_H_
+#define BENCH_BENCH_ALLOC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+extern uint64_t bench_heap_allocs;
+extern uint64_t bench_arena_allocs;
+
+// FLATCC_ALLOC / FLATCC_REALLOC / FLATCC_FREE of the host flatcc runtime
+void *bench_flatcc_malloc(size_t size);
+void *bench_flatcc_realloc(void *ptr, size_t size);
+void bench_flatcc_free(void *ptr);
+
+#endif /* BENCH_BENCH_ALLOC_H_ */
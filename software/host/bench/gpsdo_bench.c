@@ -0,0 +1,437 @@
+/*
+ * gpsdo_bench.c
+ *
+ *  Microbenchmarks of the firmware's per-PPS work on the host: the Kalman
+ *  filter predict/correct, the fixed-lag smoother pass of the manager task,
+ *  NTC temperature conversion and (when the flatcc
+ *  runtime is available) the Status/kf_debug FlatBuffer builds on the
+ *  firmware arena allocator.
+ *
+ *  Every benchmark is calibrated to a minimum batch time and sampled
+ *  repeatedly; the median and MAD of ns/op are reported together with
+ *  heap and arena allocations per op. Results can be written as CSV and
+ *  compared against a previous run to flag regressions.
+ *
+ *  usage: gpsdo_bench [options] [-o results.csv] [--compare base.csv]
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "bench_alloc.h"
+#include "filter.h"
+#include "filter_smoother.h"
+#include "manager.h"
+#include "sim_rng.h"
+#include "gpsdo_config.h"
+#include "flatbuf_message_builder.h"
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_INPUTS      1024     // power of two, indexed with a mask
+#define BENCH_MAX_SAMPLES 1001
+#define BENCH_MAX_RESULTS 16
+
+typedef struct {
+	const char *name;
+	void (*setup)(void);        // before every sample, not timed
+	void (*run)(uint32_t ops);
+} bench_t;
+
+typedef struct {
+	char name[48];
+	uint32_t ops;               // ops per sample
+	uint32_t samples;
+	double ns_median;
+	double ns_min;
+	double ns_mean;
+	double ns_mad;              // median absolute deviation
+	double heap_allocs_op;
+	double arena_allocs_op;
+} bench_result_t;
+
+static float counts[BENCH_INPUTS];
+static uint16_t adc_values[BENCH_INPUTS];
+static KF_DebugSnapshot kf_snapshot;
+static volatile float bench_sink;
+
+#ifdef BENCH_FLATCC
+// normally owned by usb.c; drained after every message like usbTask would
+QueueHandle_t xUsbTxQueue = NULL;
+static flatbuf_message_t usb_msg;
+#endif
+
+static double now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void bench_inputs_init(void) {
+	sim_rng_t rng;
+	sim_rng_seed(&rng, 1);
+
+	// 1 s gate at 5 MHz with the default measurement noise
+	for (int i = 0; i < BENCH_INPUTS; i++)
+		counts[i] = (float) (EXPECTED_CTR + 0.3 * sim_rng_gauss(&rng));
+
+	// full NTC range of the 12 bit ADC, avoiding the rails
+	for (int i = 0; i < BENCH_INPUTS; i++)
+		adc_values[i] = (uint16_t) (100 + sim_rng_uniform(&rng) * 3900.0);
+
+	filter_init();
+	for (int i = 0; i < 64; i++)
+		filter_step(counts[i], V_Mid);
+	filter_get_kf_debug_flatbuf(&kf_snapshot);
+}
+
+// ---- benchmarks ----
+
+static void setup_filter_kernel(filter_kernel_t kernel, bool steady_state,
+		bool imm) {
+	filter_config_t cfg;
+	filter_get_config(&cfg);
+	cfg.kernel = kernel;
+	cfg.steady_state = steady_state;
+	cfg.imm = imm;
+	filter_set_config(&cfg);
+
+	filter_init();
+	filter_step(counts[0], V_Mid);
+}
+
+// full covariance recursion
+static void setup_filter(void) {
+	setup_filter_kernel(FILTER_KERNEL_SYM, false, false);
+}
+
+// the generic arm_mat_* path, for A/B against the closed form kernel
+static void setup_filter_cmsis(void) {
+	setup_filter_kernel(FILTER_KERNEL_CMSIS, false, false);
+}
+
+// three mode IMM on the closed form kernel
+static void setup_filter_imm(void) {
+	setup_filter_kernel(FILTER_KERNEL_SYM, false, true);
+}
+
+// converged onto the constant DARE gain
+static void setup_filter_steady(void) {
+	setup_filter_kernel(FILTER_KERNEL_SYM, true, false);
+	for (int i = 1; !filter_is_steady_state() && i < 100000; i++)
+		filter_step(counts[i & (BENCH_INPUTS - 1)], V_Mid);
+}
+
+static void run_filter_predict(uint32_t ops) {
+	for (uint32_t i = 0; i < ops; i++)
+		filter_predict(V_Mid);
+}
+
+static void run_filter_correct(uint32_t ops) {
+	for (uint32_t i = 0; i < ops; i++)
+		filter_correct(counts[i & (BENCH_INPUTS - 1)]);
+}
+
+static void run_filter_step(uint32_t ops) {
+	for (uint32_t i = 0; i < ops; i++)
+		filter_step(counts[i & (BENCH_INPUTS - 1)], V_Mid);
+}
+
+// history for a full backward pass
+static void setup_smoother(void) {
+	setup_filter();
+	for (int i = 1; i <= FILTER_SMOOTH_LAG; i++)
+		filter_step(counts[i & (BENCH_INPUTS - 1)], V_Mid);
+}
+
+static void run_smoother(uint32_t ops) {
+	KF_SmoothSnapshot sm;
+	float acc = 0.0f;
+	for (uint32_t i = 0; i < ops; i++) {
+		smoother_run(&sm);
+		acc += sm.x[1];
+	}
+	bench_sink = acc;
+}
+
+static void run_ntc(uint32_t ops) {
+	float acc = 0.0f;
+	for (uint32_t i = 0; i < ops; i++)
+		acc += ntc_calc_temperature(adc_values[i & (BENCH_INPUTS - 1)]);
+	bench_sink = acc;
+}
+
+#ifdef BENCH_FLATCC
+static const pps_stats_t bench_pps = { .seq = 86400, .backlog_max = 1 };
+
+static void run_send_status(uint32_t ops) {
+	for (uint32_t i = 0; i < ops; i++) {
+		flatbuf_send_status(0.25f, 1.5e-3f, -2.0e-7f, V_Mid, V_Mid, 45.0f,
+				(uint32_t) counts[i & (BENCH_INPUTS - 1)], NULL, &bench_pps);
+		xQueueReceive(xUsbTxQueue, &usb_msg, 0);
+	}
+}
+
+static void run_send_kf_debug(uint32_t ops) {
+	for (uint32_t i = 0; i < ops; i++) {
+		kf_snapshot.iteration = i;
+		flatbuf_send_kf_debug(&kf_snapshot);
+		xQueueReceive(xUsbTxQueue, &usb_msg, 0);
+	}
+}
+#endif
+
+static const bench_t benches[] = {
+	{ "filter_predict", setup_filter, run_filter_predict },
+	{ "filter_correct", setup_filter, run_filter_correct },
+	{ "filter_step", setup_filter, run_filter_step },
+	{ "filter_predict_steady", setup_filter_steady, run_filter_predict },
+	{ "filter_correct_steady", setup_filter_steady, run_filter_correct },
+	{ "filter_step_steady", setup_filter_steady, run_filter_step },
+	{ "filter_predict_cmsis", setup_filter_cmsis, run_filter_predict },
+	{ "filter_correct_cmsis", setup_filter_cmsis, run_filter_correct },
+	{ "filter_step_cmsis", setup_filter_cmsis, run_filter_step },
+	{ "filter_step_imm", setup_filter_imm, run_filter_step },
+	{ "smoother_run", setup_smoother, run_smoother },
+	{ "ntc_calc_temperature", NULL, run_ntc },
+#ifdef BENCH_FLATCC
+	{ "flatbuf_send_status", NULL, run_send_status },
+	{ "flatbuf_send_kf_debug", NULL, run_send_kf_debug },
+#endif
+};
+
+#define BENCH_COUNT (sizeof(benches) / sizeof(benches[0]))
+
+// ---- statistics ----
+
+static int cmp_double(const void *a, const void *b) {
+	double x = *(const double*) a, y = *(const double*) b;
+	return (x > y) - (x < y);
+}
+
+static double median(double *v, uint32_t n) {
+	qsort(v, n, sizeof(*v), cmp_double);
+	return (n & 1) ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+static double time_batch(const bench_t *b, uint32_t ops) {
+	if (b->setup)
+		b->setup();
+	double t0 = now_ns();
+	b->run(ops);
+	return now_ns() - t0;
+}
+
+static void bench_measure(const bench_t *b, uint32_t samples, double min_ns,
+		bench_result_t *r) {
+	static double ns_op[BENCH_MAX_SAMPLES];
+	static double dev[BENCH_MAX_SAMPLES];
+
+	// grow the batch until one sample takes at least min_ns
+	uint32_t ops = 16;
+	time_batch(b, ops);
+	while (ops < (1u << 26) && time_batch(b, ops) < min_ns)
+		ops *= 2;
+
+	uint64_t heap0 = bench_heap_allocs;
+	uint64_t arena0 = bench_arena_allocs;
+	double sum = 0.0;
+
+	for (uint32_t s = 0; s < samples; s++) {
+		ns_op[s] = time_batch(b, ops) / ops;
+		sum += ns_op[s];
+	}
+
+	double total_ops = (double) ops * samples;
+	snprintf(r->name, sizeof(r->name), "%s", b->name);
+	r->ops = ops;
+	r->samples = samples;
+	r->ns_mean = sum / samples;
+	r->heap_allocs_op = (bench_heap_allocs - heap0) / total_ops;
+	r->arena_allocs_op = (bench_arena_allocs - arena0) / total_ops;
+	r->ns_median = median(ns_op, samples);
+	r->ns_min = ns_op[0];      // sorted by median()
+	for (uint32_t s = 0; s < samples; s++)
+		dev[s] = fabs(ns_op[s] - r->ns_median);
+	r->ns_mad = median(dev, samples);
+}
+
+// ---- output ----
+
+static const char *csv_header = "name,ops,samples,ns_op_median,ns_op_min,"
+		"ns_op_mean,ns_op_mad,heap_allocs_op,arena_allocs_op";
+
+static void write_csv(FILE *f, const bench_result_t *r, uint32_t n) {
+	fprintf(f, "%s\n", csv_header);
+	for (uint32_t i = 0; i < n; i++)
+		fprintf(f, "%s,%u,%u,%.3f,%.3f,%.3f,%.3f,%.4f,%.4f\n", r[i].name,
+				r[i].ops, r[i].samples, r[i].ns_median, r[i].ns_min,
+				r[i].ns_mean, r[i].ns_mad, r[i].heap_allocs_op,
+				r[i].arena_allocs_op);
+}
+
+static uint32_t read_csv(const char *path, bench_result_t *r, uint32_t max) {
+	FILE *f = fopen(path, "r");
+	if (!f) {
+		perror(path);
+		return 0;
+	}
+
+	char line[512];
+	uint32_t n = 0;
+	if (!fgets(line, sizeof(line), f)) {   // header
+		fclose(f);
+		return 0;
+	}
+	while (n < max && fgets(line, sizeof(line), f)) {
+		bench_result_t *e = &r[n];
+		if (sscanf(line, "%47[^,],%u,%u,%lf,%lf,%lf,%lf,%lf,%lf", e->name,
+				&e->ops, &e->samples, &e->ns_median, &e->ns_min, &e->ns_mean,
+				&e->ns_mad, &e->heap_allocs_op, &e->arena_allocs_op) == 9)
+			n++;
+	}
+	fclose(f);
+	return n;
+}
+
+// Returns the number of regressions against the baseline
+static int compare(const bench_result_t *cur, uint32_t n,
+		const bench_result_t *base, uint32_t n_base, double max_regress) {
+	int regressions = 0;
+
+	printf("\n%-24s %12s %12s %8s\n", "vs baseline", "base ns/op", "ns/op",
+			"change");
+	for (uint32_t i = 0; i < n; i++) {
+		const bench_result_t *b = NULL;
+		for (uint32_t j = 0; j < n_base; j++)
+			if (strcmp(base[j].name, cur[i].name) == 0)
+				b = &base[j];
+		if (!b) {
+			printf("%-24s %12s %12.1f %8s\n", cur[i].name, "-",
+					cur[i].ns_median, "new");
+			continue;
+		}
+
+		// a change inside the noise of either run is not a regression
+		double change = (cur[i].ns_median - b->ns_median) / b->ns_median;
+		double noise = (3.0 * (cur[i].ns_mad + b->ns_mad)) / b->ns_median;
+		int slower = change > max_regress && change > noise;
+		int allocs = cur[i].heap_allocs_op > b->heap_allocs_op
+				|| cur[i].arena_allocs_op > b->arena_allocs_op;
+
+		printf("%-24s %12.1f %12.1f %+7.1f%%%s%s\n", cur[i].name,
+				b->ns_median, cur[i].ns_median, 100.0 * change,
+				slower ? "  SLOWER" : "", allocs ? "  MORE ALLOCS" : "");
+		regressions += slower || allocs;
+	}
+	return regressions;
+}
+
+enum {
+	OPT_COMPARE = 256,
+	OPT_MAX_REGRESS,
+};
+
+static const struct option long_options[] = {
+	{ "samples", required_argument, NULL, 's' },
+	{ "min-time", required_argument, NULL, 't' },
+	{ "filter", required_argument, NULL, 'f' },
+	{ "compare", required_argument, NULL, OPT_COMPARE },
+	{ "max-regress", required_argument, NULL, OPT_MAX_REGRESS },
+	{ "help", no_argument, NULL, 'h' },
+	{ NULL, 0, NULL, 0 },
+};
+
+static void usage(const char *prog) {
+	fprintf(stderr,
+			"usage: %s [options]\n"
+			"  -s, --samples N          samples per benchmark (default 31)\n"
+			"  -t, --min-time MS        minimum time per sample (default 5 ms)\n"
+			"  -f, --filter TEXT        only benchmarks whose name contains TEXT\n"
+			"  -o FILE                  results table (CSV)\n"
+			"  --compare FILE           baseline CSV of a previous run\n"
+			"  --max-regress PCT        allowed slowdown of the median (default 10)\n"
+			"exits 1 if a benchmark is slower or allocates more than the baseline\n",
+			prog);
+}
+
+int main(int argc, char **argv) {
+	uint32_t samples = 31;
+	double min_ms = 5.0;
+	double max_regress = 10.0;
+	const char *filter = NULL;
+	const char *out_path = NULL;
+	const char *base_path = NULL;
+	int opt;
+
+	while ((opt = getopt_long(argc, argv, "s:t:f:o:h", long_options, NULL))
+			!= -1) {
+		switch (opt) {
+		case 's': samples = (uint32_t) atoi(optarg); break;
+		case 't': min_ms = strtod(optarg, NULL); break;
+		case 'f': filter = optarg; break;
+		case 'o': out_path = optarg; break;
+		case OPT_COMPARE: base_path = optarg; break;
+		case OPT_MAX_REGRESS: max_regress = strtod(optarg, NULL); break;
+		default:
+			usage(argv[0]);
+			return opt == 'h' ? 0 : 2;
+		}
+	}
+
+	if (samples < 1 || samples > BENCH_MAX_SAMPLES || min_ms <= 0.0) {
+		usage(argv[0]);
+		return 2;
+	}
+
+#ifdef BENCH_FLATCC
+	xUsbTxQueue = xQueueCreate(USB_TX_QUEUE_LENGTH, sizeof(flatbuf_message_t));
+#endif
+	bench_inputs_init();
+
+	static bench_result_t results[BENCH_MAX_RESULTS];
+	uint32_t n = 0;
+
+	printf("%-24s %10s %10s %10s %10s %10s %8s\n", "benchmark", "ns/op",
+			"min", "mean", "mad", "heap/op", "arena/op");
+	for (uint32_t i = 0; i < BENCH_COUNT && n < BENCH_MAX_RESULTS; i++) {
+		if (filter && !strstr(benches[i].name, filter))
+			continue;
+
+		bench_result_t *r = &results[n++];
+		bench_measure(&benches[i], samples, min_ms * 1e6, r);
+		printf("%-24s %10.1f %10.1f %10.1f %10.2f %10.2f %8.2f\n", r->name,
+				r->ns_median, r->ns_min, r->ns_mean, r->ns_mad,
+				r->heap_allocs_op, r->arena_allocs_op);
+	}
+#ifndef BENCH_FLATCC
+	printf("(flatbuf_send_* skipped: host build without the flatcc runtime)\n");
+#endif
+
+	if (out_path) {
+		FILE *out = fopen(out_path, "w");
+		if (!out) {
+			perror(out_path);
+			return 1;
+		}
+		write_csv(out, results, n);
+		fclose(out);
+	}
+
+	if (base_path) {
+		static bench_result_t base[BENCH_MAX_RESULTS];
+		uint32_t n_base = read_csv(base_path, base, BENCH_MAX_RESULTS);
+		if (n_base == 0) {
+			fprintf(stderr, "no results in %s\n", base_path);
+			return 2;
+		}
+		if (compare(results, n, base, n_base, max_regress / 100.0) > 0)
+			return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * filter_trace.c
+ *
+ *  Entry point of libgpsdo_filter (the firmware filter.c as a shared
+ *  library) for tools/com/equivalence.py. One call replays a whole
+ *  raw_counter_value stream and returns the per-step debug snapshot
+ *  fields as flat arrays, so ctypes overhead stays out of the loop.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "filter.h"
+
+#include <string.h>
+
+// Arrays are n x 3 (x, K), n x 9 (P) and n (y, S, rejected); any may be NULL.
+// Runs with the configuration filter_trace_set_config() left in place.
+// Returns the number of rejected measurements.
+uint32_t filter_trace_run(const double *raw_count, uint32_t n, float *x,
+		float *P, float *K, float *y, float *S, uint8_t *rejected) {
+	KF_DebugSnapshot kf;
+
+	filter_init();
+
+	uint32_t n_rejected = 0;
+	for (uint32_t i = 0; i < n; i++) {
+		filter_step((float) raw_count[i], 0.0f);
+		filter_get_kf_debug_flatbuf(&kf);
+
+		if (x)
+			memcpy(&x[3 * i], kf.x, sizeof(kf.x));
+		if (P)
+			memcpy(&P[9 * i], kf.P, sizeof(kf.P));
+		if (K)
+			memcpy(&K[3 * i], kf.K, sizeof(kf.K));
+		if (y)
+			y[i] = kf.y;
+		if (S)
+			S[i] = kf.S;
+		if (rejected)
+			rejected[i] = kf.rejected;
+		n_rejected += kf.rejected;
+	}
+
+	return n_rejected;
+}
+
+// filter_config_t as is; the caller mirrors the struct and checks its size
+uint32_t filter_trace_config_size(void) {
+	return sizeof(filter_config_t);
+}
+
+void filter_trace_get_config(filter_config_t *dst) {
+	filter_get_config(dst);
+}
+
+void filter_trace_set_config(const filter_config_t *cfg) {
+	filter_set_config(cfg);
+}
@@ -0,0 +1,158 @@
+/*
+ * csv_log.c
+ *
+ *  The whole file is read in one go and scanned in place; only the
+ *  raw_counter_value and voltage_control_v columns are converted, which
+ *  keeps loading of multi-week logs well below the time the replay itself
+ *  takes.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "csv_log.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CSV_RAW_COLUMN "raw_counter_value"
+#define CSV_VOLT_COLUMN "voltage_control_v"
+
+static char* csv_read_file(const char *path, size_t *len) {
+	FILE *f = fopen(path, "rb");
+	if (!f) {
+		perror(path);
+		return NULL;
+	}
+
+	fseek(f, 0, SEEK_END);
+	long size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	if (size < 0) {
+		fclose(f);
+		return NULL;
+	}
+
+	char *buf = malloc((size_t) size + 1);
+	if (buf && fread(buf, 1, (size_t) size, f) != (size_t) size) {
+		free(buf);
+		buf = NULL;
+	}
+	fclose(f);
+
+	if (buf) {
+		buf[size] = '\0';
+		*len = (size_t) size;
+	}
+	return buf;
+}
+
+// Index of the named column in the header line, or -1.
+static int csv_find_column(const char *line, const char *end, const char *name) {
+	size_t name_len = strlen(name);
+	int col = 0;
+	const char *p = line;
+
+	while (p < end) {
+		const char *field_end = p;
+		while (field_end < end && *field_end != ',')
+			field_end++;
+
+		const char *a = p, *b = field_end;
+		while (a < b && isspace((unsigned char) *a))
+			a++;
+		while (b > a && isspace((unsigned char) b[-1]))
+			b--;
+
+		if ((size_t) (b - a) == name_len && memcmp(a, name, name_len) == 0)
+			return col;
+
+		col++;
+		p = field_end + 1;
+	}
+	return -1;
+}
+
+// Start of field col of the line, NULL if the line is shorter
+static char* csv_field(char *line, char *end, int col) {
+	char *field = line;
+	for (int c = 0; c < col && field < end; c++) {
+		while (field < end && *field != ',')
+			field++;
+		field++;
+	}
+	return field < end ? field : NULL;
+}
+
+int csv_log_load(const char *path, csv_log_t *log) {
+	size_t len = 0;
+	char *buf = csv_read_file(path, &len);
+	if (!buf)
+		return -1;
+
+	memset(log, 0, sizeof(*log));
+
+	char *end = buf + len;
+	char *line_end = memchr(buf, '\n', len);
+	if (!line_end)
+		line_end = end;
+
+	int col = csv_find_column(buf, line_end, CSV_RAW_COLUMN);
+	if (col < 0) {
+		fprintf(stderr, "%s: no '%s' column\n", path, CSV_RAW_COLUMN);
+		free(buf);
+		return -1;
+	}
+	int vcol = csv_find_column(buf, line_end, CSV_VOLT_COLUMN);
+
+	// Upper bound on the number of rows
+	size_t capacity = 1;
+	for (char *p = line_end; p < end; p++)
+		if (*p == '\n')
+			capacity++;
+
+	log->raw_count = malloc(capacity * sizeof(uint32_t));
+	if (vcol >= 0)
+		log->volt = malloc(capacity * sizeof(float));
+	if (!log->raw_count || (vcol >= 0 && !log->volt)) {
+		csv_log_free(log);
+		free(buf);
+		return -1;
+	}
+
+	char *p = line_end;
+	while (p < end) {
+		char *line = p + 1;
+		if (line >= end)
+			break;
+		char *next = memchr(line, '\n', (size_t) (end - line));
+		if (!next)
+			next = end;
+
+		char *field = csv_field(line, next, col);
+		if (field) {
+			char *num_end;
+			double v = strtod(field, &num_end);
+			if (num_end != field && v >= 0.0 && v <= 4294967295.0) {
+				if (log->volt) {
+					char *vfield = csv_field(line, next, vcol);
+					// a short row keeps the previous voltage
+					log->volt[log->n] = vfield ? strtof(vfield, NULL)
+							: log->n ? log->volt[log->n - 1] : 0.0f;
+				}
+				log->raw_count[log->n++] = (uint32_t) (v + 0.5);
+			}
+		}
+		p = next;
+	}
+
+	free(buf);
+	return 0;
+}
+
+void csv_log_free(csv_log_t *log) {
+	free(log->raw_count);
+	free(log->volt);
+	memset(log, 0, sizeof(*log));
+}
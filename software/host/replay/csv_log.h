@@ -0,0 +1,25 @@
+/*
+ * csv_log.h
+ *
+ *  Loader for the CSV logs written by tools/com/reader.py.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef REPLAY_CSV_LOG_H_
+#define REPLAY_CSV_LOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+	uint32_t *raw_count;    // raw_counter_value column (PPS delta in counts)
+	float *volt;            // voltage_control_v column, NULL if not logged
+	size_t n;
+} csv_log_t;
+
+// Returns 0 on success, -1 on I/O or format errors (message on stderr).
+int csv_log_load(const char *path, csv_log_t *log);
+void csv_log_free(csv_log_t *log);
+
+#endif /* REPLAY_CSV_LOG_H_ */
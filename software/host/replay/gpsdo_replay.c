@@ -0,0 +1,189 @@
+/*
+ * gpsdo_replay.c
+ *
+ *  Replays the raw_counter_value column of logged sessions through the
+ *  firmware filter and controller, exactly in the order controllerTask
+ *  runs them on the target.
+ *
+ *  With -v the logged voltage_control_v goes to the DAC before the next
+ *  step, as it did on a target that steered the EFC, so the filter sees
+ *  the voltage steps as its control input; -b turns that input off for
+ *  comparison.
+ *
+ *  usage: gpsdo_replay [-o out.csv] [-n repeat] [-v] [-b] log.csv ...
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "csv_log.h"
+#include "filter.h"
+#include "controller.h"
+#include "gpsdo_config.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct {
+	size_t samples;
+	uint32_t outliers;
+	float phase_cnt;
+	float freq_off_Hz;
+	float freq_drift_HzDs;
+	float volt;
+} replay_result_t;
+
+static double now_s(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+static int apply_volt = 0;
+
+// Runs one logged session through the controllerTask loop body.
+static void replay_session(const csv_log_t *log, FILE *out,
+		replay_result_t *res) {
+	controller_output_t ctl = { 0 };
+	KF_DebugSnapshot kf;
+
+	// The outlier counter is not reset by filter_init(), count per session
+	filter_get_kf_debug_flatbuf(&kf);
+	uint32_t outliers_before = kf.outlier_count;
+
+	controller_init();
+	if (apply_volt)
+		DAC_SetVoltage(V_Mid);
+
+	for (size_t i = 0; i < log->n; i++) {
+		uint32_t delta = log->raw_count[i];
+
+		// the voltage of row i - 1 was on the EFC over interval i
+		if (apply_volt && i > 0)
+			DAC_SetVoltage(log->volt[i - 1]);
+
+		controller_step(delta);
+		controller_get_output(&ctl);
+
+		if (out)
+			fprintf(out, "%zu,%u,%.6f,%.6f,%.9f,%.6f\n", i, delta,
+					ctl.phase_cnt, ctl.freq_off_Hz, ctl.freq_drift_HzDs,
+					ctl.volt);
+	}
+
+	filter_get_kf_debug_flatbuf(&kf);
+
+	res->samples = log->n;
+	res->outliers = kf.outlier_count - outliers_before;
+	res->phase_cnt = ctl.phase_cnt;
+	res->freq_off_Hz = ctl.freq_off_Hz;
+	res->freq_drift_HzDs = ctl.freq_drift_HzDs;
+	res->volt = ctl.volt;
+}
+
+static void usage(const char *prog) {
+	fprintf(stderr,
+			"usage: %s [-o out.csv] [-n repeat] [-v] [-b] log.csv [log.csv ...]\n"
+					"  -o FILE  write per-sample filter/controller output\n"
+					"  -n N     replay every log N times (throughput measurement)\n"
+					"  -v       apply the logged voltage_control_v to the DAC\n"
+					"  -b       do not predict the DAC steps in the filter\n",
+			prog);
+}
+
+int main(int argc, char **argv) {
+	const char *out_path = NULL;
+	long repeat = 1;
+	filter_config_t filter_cfg;
+	int opt;
+
+	filter_get_config(&filter_cfg);
+
+	while ((opt = getopt(argc, argv, "o:n:vbh")) != -1) {
+		switch (opt) {
+		case 'o':
+			out_path = optarg;
+			break;
+		case 'n':
+			repeat = strtol(optarg, NULL, 10);
+			if (repeat < 1)
+				repeat = 1;
+			break;
+		case 'v':
+			apply_volt = 1;
+			break;
+		case 'b':
+			filter_cfg.control_input = false;
+			break;
+		default:
+			usage(argv[0]);
+			return opt == 'h' ? 0 : 2;
+		}
+	}
+
+	if (optind >= argc) {
+		usage(argv[0]);
+		return 2;
+	}
+
+	filter_set_config(&filter_cfg);
+
+	FILE *out = NULL;
+	if (out_path) {
+		out = fopen(out_path, "w");
+		if (!out) {
+			perror(out_path);
+			return 1;
+		}
+		fprintf(out, "sample,raw_counter_value,phase_cnt,freq_error_hz,"
+				"freq_drift_hz_s,voltage_control_v\n");
+	}
+
+	size_t total_samples = 0;
+	double total_time = 0.0;
+	int rc = 0;
+
+	for (int f = optind; f < argc; f++) {
+		csv_log_t log;
+		double t0 = now_s();
+		if (csv_log_load(argv[f], &log) != 0) {
+			rc = 1;
+			continue;
+		}
+		double t_load = now_s() - t0;
+
+		if (apply_volt && !log.volt) {
+			fprintf(stderr, "%s: no voltage_control_v column\n", argv[f]);
+			csv_log_free(&log);
+			rc = 1;
+			continue;
+		}
+
+		replay_result_t res = { 0 };
+		t0 = now_s();
+		for (long r = 0; r < repeat; r++)
+			replay_session(&log, (r == 0) ? out : NULL, &res);
+		double t_run = now_s() - t0;
+
+		total_samples += log.n * (size_t) repeat;
+		total_time += t_run;
+
+		printf("%s: %zu samples, %u outliers, phase %.3f cnt, freq %.6f Hz, "
+				"drift %.3e Hz/s, vctrl %.4f V (load %.3f s, %.2f Msamples/s)\n",
+				argv[f], res.samples, res.outliers, res.phase_cnt,
+				res.freq_off_Hz, res.freq_drift_HzDs, res.volt, t_load,
+				t_run > 0.0 ? (double) log.n * repeat / t_run * 1e-6 : 0.0);
+
+		csv_log_free(&log);
+	}
+
+	if (out)
+		fclose(out);
+
+	if (total_time > 0.0)
+		printf("total: %zu samples in %.3f s (%.2f Msamples/s)\n",
+				total_samples, total_time, total_samples / total_time * 1e-6);
+
+	return rc;
+}
@@ -0,0 +1,35 @@
+/*
+ * FreeRTOS.h
+ *
+ *  Host stand-in for the FreeRTOS kernel types used by the firmware.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_FREERTOS_H_
+#define HOST_FREERTOS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE  ((BaseType_t)1)
+#define pdPASS  (pdTRUE)
+#define pdFAIL  (pdFALSE)
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t)(xTimeInMs))
+
+#define configASSERT(x) do { if ((x) == 0) { host_assert_failed(__FILE__, __LINE__); } } while (0)
+
+void host_assert_failed(const char *file, int line);
+
+// Called whenever a task would block (vTaskDelay, an empty queue set with
+// a timeout). Harnesses advance their virtual time here; NULL returns at once.
+extern void (*host_block_hook)(TickType_t ticks);
+
+#endif /* HOST_FREERTOS_H_ */
@@ -0,0 +1,49 @@
+/*
+ * arm_math.h
+ *
+ *  Portable stand-in for the subset of CMSIS-DSP matrix functions used by
+ *  the firmware. Data layout and argument checking follow the CMSIS
+ *  implementation (row-major, float32, ARM_MATH_MATRIX_CHECK size checks),
+ *  so filter.c builds unchanged on the host.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_ARM_MATH_H_
+#define HOST_ARM_MATH_H_
+
+#include <stdint.h>
+
+typedef float float32_t;
+
+typedef enum {
+	ARM_MATH_SUCCESS = 0,
+	ARM_MATH_ARGUMENT_ERROR = -1,
+	ARM_MATH_LENGTH_ERROR = -2,
+	ARM_MATH_SIZE_MISMATCH = -3,
+	ARM_MATH_NANINF = -4,
+	ARM_MATH_SINGULAR = -5,
+	ARM_MATH_TEST_FAILURE = -6
+} arm_status;
+
+typedef struct {
+	uint16_t numRows;
+	uint16_t numCols;
+	float32_t *pData;
+} arm_matrix_instance_f32;
+
+void arm_mat_init_f32(arm_matrix_instance_f32 *S, uint16_t nRows,
+		uint16_t nColumns, float32_t *pData);
+
+arm_status arm_mat_add_f32(const arm_matrix_instance_f32 *pSrcA,
+		const arm_matrix_instance_f32 *pSrcB, arm_matrix_instance_f32 *pDst);
+arm_status arm_mat_sub_f32(const arm_matrix_instance_f32 *pSrcA,
+		const arm_matrix_instance_f32 *pSrcB, arm_matrix_instance_f32 *pDst);
+arm_status arm_mat_mult_f32(const arm_matrix_instance_f32 *pSrcA,
+		const arm_matrix_instance_f32 *pSrcB, arm_matrix_instance_f32 *pDst);
+arm_status arm_mat_scale_f32(const arm_matrix_instance_f32 *pSrc,
+		float32_t scale, arm_matrix_instance_f32 *pDst);
+arm_status arm_mat_trans_f32(const arm_matrix_instance_f32 *pSrc,
+		arm_matrix_instance_f32 *pDst);
+
+#endif /* HOST_ARM_MATH_H_ */
@@ -0,0 +1,103 @@
+/*
+ * arm_math_host.c
+ *
+ *  Straightforward C versions of the CMSIS-DSP matrix kernels. Products
+ *  accumulate left to right like the reference CMSIS loop so float32
+ *  rounding stays close to the target.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "arm_math.h"
+
+void arm_mat_init_f32(arm_matrix_instance_f32 *S, uint16_t nRows,
+		uint16_t nColumns, float32_t *pData) {
+	S->numRows = nRows;
+	S->numCols = nColumns;
+	S->pData = pData;
+}
+
+arm_status arm_mat_add_f32(const arm_matrix_instance_f32 *pSrcA,
+		const arm_matrix_instance_f32 *pSrcB, arm_matrix_instance_f32 *pDst) {
+#ifdef ARM_MATH_MATRIX_CHECK
+	if ((pSrcA->numRows != pSrcB->numRows)
+			|| (pSrcA->numCols != pSrcB->numCols)
+			|| (pSrcA->numRows != pDst->numRows)
+			|| (pSrcA->numCols != pDst->numCols))
+		return ARM_MATH_SIZE_MISMATCH;
+#endif
+	uint32_t n = (uint32_t) pSrcA->numRows * pSrcA->numCols;
+	for (uint32_t i = 0; i < n; i++)
+		pDst->pData[i] = pSrcA->pData[i] + pSrcB->pData[i];
+
+	return ARM_MATH_SUCCESS;
+}
+
+arm_status arm_mat_sub_f32(const arm_matrix_instance_f32 *pSrcA,
+		const arm_matrix_instance_f32 *pSrcB, arm_matrix_instance_f32 *pDst) {
+#ifdef ARM_MATH_MATRIX_CHECK
+	if ((pSrcA->numRows != pSrcB->numRows)
+			|| (pSrcA->numCols != pSrcB->numCols)
+			|| (pSrcA->numRows != pDst->numRows)
+			|| (pSrcA->numCols != pDst->numCols))
+		return ARM_MATH_SIZE_MISMATCH;
+#endif
+	uint32_t n = (uint32_t) pSrcA->numRows * pSrcA->numCols;
+	for (uint32_t i = 0; i < n; i++)
+		pDst->pData[i] = pSrcA->pData[i] - pSrcB->pData[i];
+
+	return ARM_MATH_SUCCESS;
+}
+
+arm_status arm_mat_mult_f32(const arm_matrix_instance_f32 *pSrcA,
+		const arm_matrix_instance_f32 *pSrcB, arm_matrix_instance_f32 *pDst) {
+#ifdef ARM_MATH_MATRIX_CHECK
+	if ((pSrcA->numCols != pSrcB->numRows)
+			|| (pSrcA->numRows != pDst->numRows)
+			|| (pSrcB->numCols != pDst->numCols))
+		return ARM_MATH_SIZE_MISMATCH;
+#endif
+	const uint16_t rows = pSrcA->numRows;
+	const uint16_t cols = pSrcB->numCols;
+	const uint16_t inner = pSrcA->numCols;
+
+	for (uint16_t i = 0; i < rows; i++) {
+		for (uint16_t j = 0; j < cols; j++) {
+			float32_t sum = 0.0f;
+			for (uint16_t k = 0; k < inner; k++)
+				sum += pSrcA->pData[i * inner + k] * pSrcB->pData[k * cols + j];
+			pDst->pData[i * cols + j] = sum;
+		}
+	}
+
+	return ARM_MATH_SUCCESS;
+}
+
+arm_status arm_mat_scale_f32(const arm_matrix_instance_f32 *pSrc,
+		float32_t scale, arm_matrix_instance_f32 *pDst) {
+#ifdef ARM_MATH_MATRIX_CHECK
+	if ((pSrc->numRows != pDst->numRows) || (pSrc->numCols != pDst->numCols))
+		return ARM_MATH_SIZE_MISMATCH;
+#endif
+	uint32_t n = (uint32_t) pSrc->numRows * pSrc->numCols;
+	for (uint32_t i = 0; i < n; i++)
+		pDst->pData[i] = pSrc->pData[i] * scale;
+
+	return ARM_MATH_SUCCESS;
+}
+
+arm_status arm_mat_trans_f32(const arm_matrix_instance_f32 *pSrc,
+		arm_matrix_instance_f32 *pDst) {
+#ifdef ARM_MATH_MATRIX_CHECK
+	if ((pSrc->numRows != pDst->numCols) || (pSrc->numCols != pDst->numRows))
+		return ARM_MATH_SIZE_MISMATCH;
+#endif
+	const uint16_t rows = pSrc->numRows;
+	const uint16_t cols = pSrc->numCols;
+
+	for (uint16_t i = 0; i < rows; i++)
+		for (uint16_t j = 0; j < cols; j++)
+			pDst->pData[j * rows + i] = pSrc->pData[i * cols + j];
+
+	return ARM_MATH_SUCCESS;
+}
@@ -0,0 +1,49 @@
+/*
+ * cmsis_os.h
+ *
+ *  Host stand-in for the CMSIS-RTOS2 API. There is no scheduler on the
+ *  host: tasks are never started, semaphores and thread flags are plain
+ *  flags that the replay and simulation drivers poll, and delays return
+ *  immediately.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_CMSIS_OS_H_
+#define HOST_CMSIS_OS_H_
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+typedef enum {
+	osOK = 0, osError = -1, osErrorTimeout = -2, osErrorResource = -3
+} osStatus_t;
+
+#define osWaitForever 0xFFFFFFFFU
+
+typedef struct {
+	volatile uint32_t count;
+	uint32_t max_count;
+} host_semaphore_t;
+
+typedef host_semaphore_t *osSemaphoreId_t;
+
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout);
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id);
+
+typedef struct {
+	volatile uint32_t flags;
+} host_thread_t;
+
+typedef host_thread_t *osThreadId_t;
+
+#define osFlagsWaitAny        0x00000000U
+#define osFlagsErrorResource  0xFFFFFFFDU
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags);
+// Waits on tsk_controllerHandle, the only thread that takes flags
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout);
+
+osStatus_t osDelay(uint32_t ticks);
+
+#endif /* HOST_CMSIS_OS_H_ */
@@ -0,0 +1,151 @@
+/*
+ * cmsis_os_host.c
+ *
+ *  Minimal RTOS objects for the host build: counting semaphores, thread
+ *  flags, fixed-size queues and queue sets without blocking.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "cmsis_os.h"
+#include "queue.h"
+#include "task.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout) {
+	(void) timeout;
+	if (semaphore_id->count == 0)
+		return osErrorResource;
+
+	semaphore_id->count--;
+	return osOK;
+}
+
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id) {
+	if (semaphore_id->count >= semaphore_id->max_count)
+		return osErrorResource;
+
+	semaphore_id->count++;
+	return osOK;
+}
+
+static host_thread_t controller_thread;
+osThreadId_t tsk_controllerHandle = &controller_thread;
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags) {
+	thread_id->flags |= flags;
+	return thread_id->flags;
+}
+
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout) {
+	(void) options;
+	(void) timeout;
+	const uint32_t set = tsk_controllerHandle->flags & flags;
+	if (set == 0)
+		return osFlagsErrorResource;
+
+	tsk_controllerHandle->flags &= ~set;
+	return set;
+}
+
+osStatus_t osDelay(uint32_t ticks) {
+	(void) ticks;
+	return osOK;
+}
+
+void (*host_block_hook)(TickType_t ticks) = NULL;
+
+void vTaskDelay(const TickType_t xTicksToDelay) {
+	if (host_block_hook)
+		host_block_hook(xTicksToDelay);
+}
+
+// ---- Queues ----
+
+struct host_queue {
+	UBaseType_t length;
+	UBaseType_t item_size;
+	UBaseType_t head;
+	UBaseType_t count;
+	uint8_t *storage;
+	struct host_queue *set;     // queue set this queue is a member of
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize) {
+	struct host_queue *q = calloc(1, sizeof(*q));
+	if (!q)
+		return NULL;
+
+	q->storage = calloc(uxQueueLength, uxItemSize);
+	if (!q->storage) {
+		free(q);
+		return NULL;
+	}
+	q->length = uxQueueLength;
+	q->item_size = uxItemSize;
+	return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void *pvItemToQueue,
+		TickType_t xTicksToWait) {
+	(void) xTicksToWait;
+	if (!xQueue || xQueue->count >= xQueue->length)
+		return pdFAIL;
+
+	UBaseType_t tail = (xQueue->head + xQueue->count) % xQueue->length;
+	memcpy(xQueue->storage + tail * xQueue->item_size, pvItemToQueue,
+			xQueue->item_size);
+	xQueue->count++;
+
+	if (xQueue->set)
+		xQueueSend(xQueue->set, &xQueue, 0);
+	return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer,
+		TickType_t xTicksToWait) {
+	(void) xTicksToWait;
+	if (!xQueue || xQueue->count == 0)
+		return pdFALSE;
+
+	memcpy(pvBuffer, xQueue->storage + xQueue->head * xQueue->item_size,
+			xQueue->item_size);
+	xQueue->head = (xQueue->head + 1) % xQueue->length;
+	xQueue->count--;
+	return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue) {
+	return xQueue ? xQueue->count : 0;
+}
+
+// ---- Queue sets ----
+
+QueueSetHandle_t xQueueCreateSet(UBaseType_t uxEventQueueLength) {
+	return xQueueCreate(uxEventQueueLength, sizeof(QueueSetMemberHandle_t));
+}
+
+BaseType_t xQueueAddToSet(QueueSetMemberHandle_t xQueueOrSemaphore,
+		QueueSetHandle_t xQueueSet) {
+	if (!xQueueOrSemaphore || xQueueOrSemaphore->set
+			|| xQueueOrSemaphore->count != 0)
+		return pdFAIL;
+
+	xQueueOrSemaphore->set = xQueueSet;
+	return pdPASS;
+}
+
+QueueSetMemberHandle_t xQueueSelectFromSet(QueueSetHandle_t xQueueSet,
+		TickType_t xTicksToWait) {
+	QueueSetMemberHandle_t member = NULL;
+
+	if (uxQueueMessagesWaiting(xQueueSet) == 0 && xTicksToWait > 0
+			&& host_block_hook)
+		host_block_hook(xTicksToWait);
+
+	if (xQueueReceive(xQueueSet, &member, 0) != pdTRUE)
+		return NULL;
+	return member;
+}
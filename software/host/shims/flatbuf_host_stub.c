@@ -0,0 +1,48 @@
+/*
+ * flatbuf_host_stub.c
+ *
+ *  Telemetry sink used when the host build is configured without the
+ *  flatcc runtime. Messages are counted and dropped.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "flatbuf_message_builder.h"
+
+static uint32_t flatbuf_stub_status_count = 0;
+static uint32_t flatbuf_stub_kf_debug_count = 0;
+static uint32_t flatbuf_stub_profile_count = 0;
+static uint32_t flatbuf_stub_kf_smooth_count = 0;
+
+void flatbuf_send_kf_debug(const KF_DebugSnapshot *kf) {
+	(void) kf;
+	flatbuf_stub_kf_debug_count++;
+}
+
+void flatbuf_send_status(float phase_cnt, float freq_error, float freq_drift,
+		float vctrl, float vmeas, float temp, uint32_t raw_counter_value,
+		const float *mode_prob, const pps_stats_t *pps) {
+	(void) phase_cnt;
+	(void) freq_error;
+	(void) freq_drift;
+	(void) vctrl;
+	(void) vmeas;
+	(void) temp;
+	(void) raw_counter_value;
+	(void) mode_prob;
+	(void) pps;
+	flatbuf_stub_status_count++;
+}
+
+void flatbuf_send_profile(uint8_t section, const profile_stats_t *stats,
+		uint32_t cpu_hz) {
+	(void) section;
+	(void) stats;
+	(void) cpu_hz;
+	flatbuf_stub_profile_count++;
+}
+
+void flatbuf_send_kf_smooth(const KF_SmoothSnapshot *sm) {
+	(void) sm;
+	flatbuf_stub_kf_smooth_count++;
+}
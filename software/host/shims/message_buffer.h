@@ -0,0 +1,14 @@
+/*
+ * message_buffer.h
+ *
+ *  Host stand-in for FreeRTOS message buffers (declared in usb.h only).
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_MESSAGE_BUFFER_H_
+#define HOST_MESSAGE_BUFFER_H_
+
+typedef struct host_message_buffer *MessageBufferHandle_t;
+
+#endif /* HOST_MESSAGE_BUFFER_H_ */
@@ -0,0 +1,35 @@
+/*
+ * queue.h
+ *
+ *  Host stand-in for FreeRTOS queues. Queues are fixed-size FIFOs with
+ *  non-blocking semantics; a send to a full queue fails immediately.
+ *  Selecting from an empty queue set gives host_block_hook a chance to
+ *  produce items first.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_QUEUE_H_
+#define HOST_QUEUE_H_
+
+#include "FreeRTOS.h"
+
+typedef struct host_queue *QueueHandle_t;
+typedef struct host_queue *QueueSetHandle_t;
+typedef struct host_queue *QueueSetMemberHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize);
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void *pvItemToQueue,
+		TickType_t xTicksToWait);
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer,
+		TickType_t xTicksToWait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue);
+
+// Queue sets: every item sent to a member posts the member to the set
+QueueSetHandle_t xQueueCreateSet(UBaseType_t uxEventQueueLength);
+BaseType_t xQueueAddToSet(QueueSetMemberHandle_t xQueueOrSemaphore,
+		QueueSetHandle_t xQueueSet);
+QueueSetMemberHandle_t xQueueSelectFromSet(QueueSetHandle_t xQueueSet,
+		TickType_t xTicksToWait);
+
+#endif /* HOST_QUEUE_H_ */
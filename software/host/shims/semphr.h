@@ -0,0 +1,15 @@
+/*
+ * semphr.h
+ *
+ *  Host stand-in; the firmware uses the CMSIS-RTOS2 semaphore API from
+ *  cmsis_os.h.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_SEMPHR_H_
+#define HOST_SEMPHR_H_
+
+#include "queue.h"
+
+#endif /* HOST_SEMPHR_H_ */
@@ -0,0 +1,164 @@
+/*
+ * stm32f4xx_hal.h
+ *
+ *  Host stand-in for the STM32F4 HAL. Only the peripherals the firmware
+ *  modules under src/ touch are modelled: the TIM1/TIM2/TIM5 counter chain,
+ *  GPIO outputs (LEDs, DAC sync), the DAC SPI bus and the DWT cycle counter.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_STM32F4XX_HAL_H_
+#define HOST_STM32F4XX_HAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum {
+	HAL_OK = 0x00U, HAL_ERROR = 0x01U, HAL_BUSY = 0x02U, HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+
+#define __NOP() do { } while (0)
+#define __weak __attribute__((weak))
+
+// ---- Core (interrupt mask, barrier, CLZ) ----
+
+extern uint32_t host_primask;
+
+static inline uint32_t __get_PRIMASK(void) {
+	return host_primask;
+}
+
+static inline void __set_PRIMASK(uint32_t primask) {
+	host_primask = primask;
+}
+
+static inline void __disable_irq(void) {
+	host_primask = 1U;
+}
+
+static inline void __enable_irq(void) {
+	host_primask = 0U;
+}
+
+static inline void __DMB(void) {
+	__sync_synchronize();
+}
+
+static inline uint8_t __CLZ(uint32_t value) {
+	return (value == 0U) ? 32U : (uint8_t) __builtin_clz(value);
+}
+
+// ---- DWT cycle counter ----
+
+// CYCCNT is not advanced on the host, profiled sections read as 0 cycles
+typedef struct {
+	volatile uint32_t CTRL;
+	volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+	volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+extern DWT_Type host_dwt;
+extern CoreDebug_Type host_coredebug;
+
+#define DWT (&host_dwt)
+#define CoreDebug (&host_coredebug)
+
+extern uint32_t SystemCoreClock;
+
+// ---- Timers ----
+
+typedef struct {
+	volatile uint32_t CR1;
+	volatile uint32_t SR;
+	volatile uint32_t CNT;
+	volatile uint32_t ARR;
+	volatile uint32_t CCR1;
+	volatile uint32_t CCR2;
+	volatile uint32_t CCR3;
+	volatile uint32_t CCR4;
+} TIM_TypeDef;
+
+typedef enum {
+	HAL_TIM_ACTIVE_CHANNEL_1 = 0x01U,
+	HAL_TIM_ACTIVE_CHANNEL_2 = 0x02U,
+	HAL_TIM_ACTIVE_CHANNEL_3 = 0x04U,
+	HAL_TIM_ACTIVE_CHANNEL_4 = 0x08U,
+	HAL_TIM_ACTIVE_CHANNEL_CLEARED = 0x00U
+} HAL_TIM_ActiveChannel;
+
+typedef struct {
+	TIM_TypeDef *Instance;
+	HAL_TIM_ActiveChannel Channel;
+} TIM_HandleTypeDef;
+
+#define TIM_SR_CC3IF  (1UL << 3)
+#define TIM_SR_CC3OF  (1UL << 11)
+
+#define TIM_CHANNEL_1 0x00000000U
+#define TIM_CHANNEL_2 0x00000004U
+#define TIM_CHANNEL_3 0x00000008U
+#define TIM_CHANNEL_4 0x0000000CU
+
+extern TIM_TypeDef host_tim1;
+extern TIM_TypeDef host_tim2;
+extern TIM_TypeDef host_tim5;
+
+#define TIM1 (&host_tim1)
+#define TIM2 (&host_tim2)
+#define TIM5 (&host_tim5)
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_IC_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_IC_Start_IT(TIM_HandleTypeDef *htim, uint32_t Channel);
+void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim);
+
+// ---- GPIO ----
+
+typedef struct {
+	volatile uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef enum {
+	GPIO_PIN_RESET = 0, GPIO_PIN_SET
+} GPIO_PinState;
+
+#define GPIO_PIN_13 ((uint16_t)0x2000)
+#define GPIO_PIN_14 ((uint16_t)0x4000)
+#define GPIO_PIN_15 ((uint16_t)0x8000)
+
+extern GPIO_TypeDef host_gpioa;
+extern GPIO_TypeDef host_gpioc;
+
+#define GPIOA (&host_gpioa)
+#define GPIOC (&host_gpioc)
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin,
+		GPIO_PinState PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+// ---- SPI (DAC) ----
+
+typedef struct {
+	uint16_t last_word;     // last 16 bit word shifted out, MSB first
+	uint32_t tx_count;      // number of completed transfers
+} SPI_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData,
+		uint16_t Size, uint32_t Timeout);
+
+// ---- ADC ----
+
+typedef struct {
+	uint32_t unused;
+} ADC_HandleTypeDef;
+
+#endif /* HOST_STM32F4XX_HAL_H_ */
@@ -0,0 +1,82 @@
+/*
+ * stm32f4xx_hal_host.c
+ *
+ *  Peripheral state and HAL entry points for the host build. Drivers
+ *  (replay, simulator) write the timer registers directly and then call
+ *  HAL_TIM_IC_CaptureCallback(&htim5) the way the TIM5 IRQ would.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "hal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+TIM_TypeDef host_tim1;
+TIM_TypeDef host_tim2;
+TIM_TypeDef host_tim5;
+
+GPIO_TypeDef host_gpioa;
+GPIO_TypeDef host_gpioc;
+
+DWT_Type host_dwt;
+CoreDebug_Type host_coredebug;
+uint32_t host_primask;
+uint32_t SystemCoreClock = 96000000U;
+
+// Handles normally owned by main.c
+TIM_HandleTypeDef htim1 = { .Instance = TIM1 };
+TIM_HandleTypeDef htim2 = { .Instance = TIM2 };
+TIM_HandleTypeDef htim5 = { .Instance = TIM5 };
+
+ADC_HandleTypeDef hadc1;
+SPI_HandleTypeDef hspi1;
+USBD_HandleTypeDef hUsbDeviceFS = { .dev_state = USBD_STATE_CONFIGURED };
+
+uint16_t adc_dma_buffer[2];
+uint8_t hal_initialized = 1;
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim) {
+	htim->Instance->CR1 |= 1U;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_IC_Start(TIM_HandleTypeDef *htim, uint32_t Channel) {
+	(void) Channel;
+	htim->Instance->CR1 |= 1U;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_IC_Start_IT(TIM_HandleTypeDef *htim,
+		uint32_t Channel) {
+	(void) Channel;
+	htim->Instance->CR1 |= 1U;
+	return HAL_OK;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin,
+		GPIO_PinState PinState) {
+	if (PinState == GPIO_PIN_SET)
+		GPIOx->ODR |= GPIO_Pin;
+	else
+		GPIOx->ODR &= ~(uint32_t) GPIO_Pin;
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin) {
+	GPIOx->ODR ^= GPIO_Pin;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData,
+		uint16_t Size, uint32_t Timeout) {
+	(void) Timeout;
+	if (Size >= 2)
+		hspi->last_word = (uint16_t) ((pData[0] << 8) | pData[1]);
+	hspi->tx_count++;
+	return HAL_OK;
+}
+
+void host_assert_failed(const char *file, int line) {
+	fprintf(stderr, "configASSERT failed at %s:%d\n", file, line);
+	abort();
+}
@@ -0,0 +1,17 @@
+/*
+ * task.h
+ *
+ *  Host stand-in for the FreeRTOS task API. There is no scheduler; a
+ *  delay only calls host_block_hook so harnesses can advance time.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_TASK_H_
+#define HOST_TASK_H_
+
+#include "FreeRTOS.h"
+
+void vTaskDelay(const TickType_t xTicksToDelay);
+
+#endif /* HOST_TASK_H_ */
@@ -0,0 +1,14 @@
+/*
+ * timers.h
+ *
+ *  Host stand-in; no software timers are used by the modules built here.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_TIMERS_H_
+#define HOST_TIMERS_H_
+
+#include "FreeRTOS.h"
+
+#endif /* HOST_TIMERS_H_ */
@@ -0,0 +1,14 @@
+/*
+ * usb_device.h
+ *
+ *  Host stand-in; MX_USB_DEVICE_Init() is provided by the harness.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_USB_DEVICE_H_
+#define HOST_USB_DEVICE_H_
+
+void MX_USB_DEVICE_Init(void);
+
+#endif /* HOST_USB_DEVICE_H_ */
@@ -0,0 +1,27 @@
+/*
+ * usbd_cdc_if.h
+ *
+ *  Host stand-in for the CDC class interface. CDC_Transmit_FS() is
+ *  provided by the harness that models the endpoint.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_USBD_CDC_IF_H_
+#define HOST_USBD_CDC_IF_H_
+
+#include "usbd_def.h"
+
+#define CDC_DATA_FS_MAX_PACKET_SIZE 64U
+
+// subset of the class data behind hUsbDeviceFS.pClassData
+typedef struct {
+	uint8_t *TxBuffer;
+	uint32_t TxLength;
+	volatile uint32_t TxState;
+	volatile uint32_t RxState;
+} USBD_CDC_HandleTypeDef;
+
+uint8_t CDC_Transmit_FS(uint8_t *Buf, uint16_t Len);
+
+#endif /* HOST_USBD_CDC_IF_H_ */
@@ -0,0 +1,14 @@
+/*
+ * usbd_core.h
+ *
+ *  Host stand-in for the ST USB device core.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_USBD_CORE_H_
+#define HOST_USBD_CORE_H_
+
+#include "usbd_def.h"
+
+#endif /* HOST_USBD_CORE_H_ */
@@ -0,0 +1,28 @@
+/*
+ * usbd_def.h
+ *
+ *  Host stand-in for the ST USB device library handle.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_USBD_DEF_H_
+#define HOST_USBD_DEF_H_
+
+#include <stdint.h>
+
+#define USBD_STATE_DEFAULT     0x01U
+#define USBD_STATE_ADDRESSED   0x02U
+#define USBD_STATE_CONFIGURED  0x03U
+#define USBD_STATE_SUSPENDED   0x04U
+
+typedef enum {
+	USBD_OK = 0U, USBD_BUSY, USBD_EMEM, USBD_FAIL
+} USBD_StatusTypeDef;
+
+typedef struct {
+	volatile uint8_t dev_state;
+	void *pClassData;
+} USBD_HandleTypeDef;
+
+#endif /* HOST_USBD_DEF_H_ */
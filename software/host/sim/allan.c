@@ -0,0 +1,24 @@
+/*
+ * allan.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "allan.h"
+
+#include <math.h>
+
+double allan_deviation(const double *x, size_t n, double tau0_s, size_t m) {
+	if (m == 0 || n < 2 * m + 1)
+		return -1.0;
+
+	double sum = 0.0;
+	size_t terms = n - 2 * m;
+	for (size_t i = 0; i < terms; i++) {
+		double d = x[i + 2 * m] - 2.0 * x[i + m] + x[i];
+		sum += d * d;
+	}
+
+	double tau = (double) m * tau0_s;
+	return sqrt(sum / (2.0 * tau * tau * (double) terms));
+}
@@ -0,0 +1,18 @@
+/*
+ * allan.h
+ *
+ *  Overlapping Allan deviation from time error samples.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SIM_ALLAN_H_
+#define SIM_ALLAN_H_
+
+#include <stddef.h>
+
+// x: time error in seconds, sampled every tau0_s. Returns ADEV at
+// tau = m * tau0_s, or -1 if there are not enough samples.
+double allan_deviation(const double *x, size_t n, double tau0_s, size_t m);
+
+#endif /* SIM_ALLAN_H_ */
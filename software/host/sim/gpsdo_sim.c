@@ -0,0 +1,284 @@
+/*
+ * gpsdo_sim.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "gpsdo_sim.h"
+#include "allan.h"
+#include "hal.h"
+#include "pps.h"
+#include "profile.h"
+#include "filter.h"
+#include "controller.h"
+#include "manager.h"
+#include "gpsdo_config.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <time.h>
+
+const double sim_adev_tau_s[SIM_ADEV_TAUS] = { 1.0, 10.0, 100.0, 1000.0 };
+
+void sim_config_defaults(sim_config_t *cfg) {
+	*cfg = (sim_config_t ) {
+		.duration_s = 86400.0,
+		.seed = 1,
+		.open_loop = 0,
+		.ocxo = {
+			.y0 = 2.0e-8,
+			.wfm_adev = 1.0e-11,
+			.ffm_adev = 5.0e-12,
+			.rwfm_step = 1.0e-13,
+			.aging_per_day = 1.0e-10,
+			.tempco_per_C = 1.0e-11,
+			.temp_amp_C = 2.0,
+			.temp_period_s = 1800.0,
+			.efc_gain_scale = 1.0,
+		},
+		.pps = {
+			.jitter_s = 5.0e-9,
+			.sawtooth_s = 20.8e-9,
+			.sawtooth_rate = 0.137,
+			.drop_prob = 1.0e-4,
+			.extra_prob = 1.0e-5,
+			.outage_start_s = 0.0,
+			.outage_len_s = 0.0,
+			.phase_step_at_s = 0.0,
+			.phase_step_s = 0.0,
+		},
+		.isr_latency_s = 1.5e-6,
+		.isr_tail_s = 0.5e-6,
+		.latch = 0,
+		.latch_noise_prob = 0.0,
+		.late_prob = 0.0,
+		.efc_step_s = 0.0,
+		.efc_step_V = 0.0,
+		.lock_threshold = 1.0e-9,
+		.lock_hold_s = 600.0,
+		.trace = NULL,
+		.trace_decimation = 1,
+	};
+}
+
+static double now_s(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+// voltage the DAC actually outputs (last code clocked out over SPI)
+static float dac_output_V(void) {
+	return (float) hspi1.last_word * DAC_VREF / 65535.0f;
+}
+
+// NTC divider of the board (as ntc_calc_temperature()) read by the 12 bit ADC
+static uint16_t sim_ntc_adc(double temp_C) {
+	const double r = 10e3, r25 = 10e3, beta = 3425.0;
+	double r_ntc = r25 * exp(beta * (1.0 / (temp_C + 273.15)
+			- 1.0 / (273.15 + 25.0)));
+	double code = round(4096.0 * r_ntc / (r + r_ntc));
+
+	return (uint16_t) (code > 4095.0 ? 4095.0 : code);
+}
+
+// TIM2:TIM1 hold the 32 bit cascade of the divided OCXO counter, read by
+// the callback at count_read; TIM1 CH3 latched the low word of count_edge.
+// TIM5 counts the core clock, CCR1 at the edge and CNT at the read.
+static void sim_capture(double t_edge, double latency, uint64_t count_edge,
+		uint64_t count_read, int latch) {
+	TIM5->CCR1 = (uint32_t) (uint64_t) (t_edge * SystemCoreClock);
+	TIM5->CNT = (uint32_t) (uint64_t) ((t_edge + latency) * SystemCoreClock);
+
+	TIM1->CCR3 = (uint32_t) (count_edge & 0xFFFF);
+	TIM1->SR &= ~TIM_SR_CC3OF;
+	if (latch)
+		TIM1->SR |= TIM_SR_CC3IF;
+	else
+		TIM1->SR &= ~TIM_SR_CC3IF;
+
+	TIM2->CNT = (uint32_t) (count_read >> 16);
+	TIM1->CNT = (uint32_t) (count_read & 0xFFFF);
+	HAL_TIM_IC_CaptureCallback(&htim5);
+}
+
+int sim_run(const sim_config_t *cfg, sim_result_t *res) {
+	size_t n = (size_t) cfg->duration_s;
+	double *x = malloc((n + 1) * sizeof(*x));
+	if (!x)
+		return -1;
+
+	double t_start = now_s();
+	sim_rng_t rng, isr_rng;
+	ocxo_t ocxo;
+	pps_model_t pps;
+	controller_output_t ctl = { 0 };
+	KF_DebugSnapshot kf;
+
+	sim_rng_seed(&rng, cfg->seed);
+	sim_rng_seed(&isr_rng, ~cfg->seed);   // keeps the OCXO/PPS sequences
+	ocxo_init(&ocxo, &cfg->ocxo, &rng);
+	pps_model_init(&pps, &cfg->pps, &rng);
+
+	*res = (sim_result_t ) { .lock_time_s = -1.0 };
+
+	// The outlier counter is not reset by filter_init(), count per run
+	filter_get_kf_debug_flatbuf(&kf);
+	uint32_t outliers_before = kf.outlier_count;
+
+	// power up as controllerTask does
+	osThreadFlagsWait(PPS_THREAD_FLAG, osFlagsWaitAny, 0);
+	pps_init();
+	profile_reset();
+	controller_init();
+	controller_get_output(&ctl);
+	DAC_SetVoltage(ctl.volt);
+
+	double lock_candidate = 0.0;
+	double track_sq = 0.0;
+	double step_sum = 0.0, step_sq = 0.0;
+	uint32_t step_n = 0;
+	double outage_x0 = 0.0;
+	int in_outage = 0;
+	uint32_t trace_dec = cfg->trace_decimation ? cfg->trace_decimation : 1;
+
+	if (cfg->trace)
+		fprintf(cfg->trace, "t_s,y,time_error_s,efc_v,phase_cnt,"
+				"freq_error_hz,freq_drift_hz_s,voltage_control_v\n");
+
+	for (size_t k = 0; k < n; k++) {
+		double t = (double) k;
+		if (cfg->efc_step_V != 0.0 && t == cfg->efc_step_s)
+			DAC_SetVoltage(dac_output_V() + (float) cfg->efc_step_V);
+
+		float efc_V = dac_output_V();
+		double y = ocxo_begin_second(&ocxo, efc_V);
+		x[k] = ocxo_time_error(&ocxo);
+
+		// mangerTask samples the NTC and runs the smoother once a second
+		adc_dma_buffer[1] = sim_ntc_adc(ocxo.temp_C);
+		manager_second();
+
+		double edges[PPS_MODEL_MAX_EDGES];
+		int n_edges = pps_model_edges(&pps, t, edges);
+
+		for (int e = 0; e < n_edges; e++) {
+			double latency = cfg->isr_latency_s
+					- cfg->isr_tail_s * log(1.0 - sim_rng_uniform(&isr_rng));
+			uint64_t count_edge = ocxo_count_at(&ocxo, edges[e]);
+			uint64_t count_read = ocxo_count_at(&ocxo, edges[e] + latency);
+			// noise on PA10 latched anywhere in the 13 ms wrap of the
+			// low word instead
+			if (cfg->latch && cfg->latch_noise_prob > 0.0
+					&& sim_rng_uniform(&isr_rng) < cfg->latch_noise_prob)
+				count_edge = count_read
+						- (uint64_t) (65536.0 * sim_rng_uniform(&isr_rng));
+			sim_capture(edges[e], latency, count_edge, count_read, cfg->latch);
+
+			// controllerTask wakes on the thread flag right after the ISR,
+			// unless it is held up past the edge; then it drains the ring
+			// on a later one
+			if (cfg->late_prob > 0.0
+					&& sim_rng_uniform(&isr_rng) < cfg->late_prob)
+				continue;
+			if (osThreadFlagsWait(PPS_THREAD_FLAG, osFlagsWaitAny, 0)
+					== osFlagsErrorResource)
+				continue;
+
+			uint32_t delta;
+			while (pps_get_delta(&delta)) {
+				float volt = controller_step(delta);
+				if (!cfg->open_loop)
+					DAC_SetVoltage(volt);
+				res->steps++;
+
+				double e = filter_get_phase_count() - EXPECTED_CTR * y;
+				track_sq += e * e;
+
+				if (cfg->efc_step_V != 0.0 && t >= cfg->efc_step_s
+						&& t < cfg->efc_step_s + SIM_STEP_WINDOW_S) {
+					step_sum += e;
+					step_sq += e * e;
+					step_n++;
+					if (fabs(e) > res->step_peak_cnt)
+						res->step_peak_cnt = fabs(e);
+				}
+			}
+		}
+
+		ocxo_end_second(&ocxo);
+
+		// lock: |y| below threshold for lock_hold_s without interruption
+		if (res->lock_time_s < 0.0) {
+			if (fabs(y) >= cfg->lock_threshold)
+				lock_candidate = t + 1.0;
+			else if (t + 1.0 - lock_candidate >= cfg->lock_hold_s)
+				res->lock_time_s = lock_candidate;
+		}
+
+		// holdover: time error accumulated since the PPS disappeared
+		if (pps_model_in_outage(&pps, t)) {
+			if (!in_outage) {
+				outage_x0 = x[k];
+				in_outage = 1;
+			}
+			double dx = fabs(x[k] - outage_x0);
+			if (dx > res->holdover_error_s)
+				res->holdover_error_s = dx;
+		} else
+			in_outage = 0;
+
+		if (cfg->trace && k % trace_dec == 0) {
+			controller_get_output(&ctl);
+			fprintf(cfg->trace, "%zu,%.6e,%.9e,%.6f,%.6f,%.6f,%.9f,%.6f\n",
+					k, y, x[k], efc_V, ctl.phase_cnt, ctl.freq_off_Hz,
+					ctl.freq_drift_HzDs, ctl.volt);
+		}
+
+		res->final_y = y;
+
+		if (cfg->on_second && cfg->on_second(t, cfg->ctx)) {
+			n = k + 1;
+			break;
+		}
+	}
+	x[n] = ocxo_time_error(&ocxo);
+
+	// stability of the disciplined output once settled
+	size_t settle = (res->lock_time_s >= 0.0) ?
+			(size_t) res->lock_time_s : n / 2;
+	for (int i = 0; i < SIM_ADEV_TAUS; i++)
+		res->adev[i] = allan_deviation(x + settle, n + 1 - settle, 1.0,
+				(size_t) sim_adev_tau_s[i]);
+
+	filter_get_kf_debug_flatbuf(&kf);
+	controller_get_output(&ctl);
+
+	res->seconds = (double) n;
+	res->final_time_error_s = x[n];
+	res->final_volt = ctl.volt;
+	res->track_rms_cnt = res->steps ? sqrt(track_sq / res->steps) : 0.0;
+	res->step_mean_cnt = step_n ? step_sum / step_n : 0.0;
+	res->step_rms_cnt = step_n ? sqrt(step_sq / step_n) : 0.0;
+	res->outliers = kf.outlier_count - outliers_before;
+	res->reacqs = kf.reacq_count;
+	filter_get_gap_stats(&res->gap_seconds, &res->glitches);
+	res->pulses = pps.pulses;
+	res->dropped = pps.dropped;
+	res->extra = pps.extra;
+	pps_stats_t pps_stats;
+	pps_get_stats(&pps_stats);
+	res->sw_reads = pps_stats.sw_reads;
+	res->overruns = pps_stats.overruns;
+	res->backlog_max = pps_stats.backlog_max;
+
+	profile_stats_t lat;
+	profile_get(PROFILE_PPS_READ_LATENCY, &lat);
+	const double us = 1e6 / profile_cpu_hz();
+	res->read_latency_us = lat.count ? (double) lat.sum / lat.count * us : 0.0;
+	res->read_latency_max_us = lat.count ? lat.max * us : 0.0;
+	res->wall_time_s = now_s() - t_start;
+
+	free(x);
+	return 0;
+}
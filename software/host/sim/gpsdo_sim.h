@@ -0,0 +1,94 @@
+/*
+ * gpsdo_sim.h
+ *
+ *  Closed-loop GPSDO simulation: the OCXO and PPS models drive the
+ *  TIM1/TIM2 counter shims, the unchanged pps.c capture callback and
+ *  controller_step() run as on the target, and the control voltage is
+ *  fed back through DAC_SetVoltage() into the OCXO EFC.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SIM_GPSDO_SIM_H_
+#define SIM_GPSDO_SIM_H_
+
+#include "ocxo_model.h"
+#include "pps_model.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define SIM_ADEV_TAUS 4         // 1, 10, 100, 1000 s
+#define SIM_STEP_WINDOW_S 600   // step response scored over this long
+
+typedef struct {
+	double duration_s;
+	uint64_t seed;
+	int open_loop;              // do not write the DAC (as controllerTask today)
+
+	ocxo_params_t ocxo;
+	pps_params_t pps;
+
+	// PPS edge to the software counter read in the capture callback: a
+	// fixed part plus an exponential tail (other interrupts in the way)
+	double isr_latency_s;
+	double isr_tail_s;
+	int latch;                  // PA10 wired: TIM1 CH3 latches the count
+	                            // (a PPS_LATCH build), else the read counts
+	double latch_noise_prob;    // the latch holds a noise edge instead
+	double late_prob;           // controllerTask not woken by an edge, it
+	                            // catches up on a later one
+
+	// open loop EFC step of efc_step_V at efc_step_s (0 V: none), the
+	// filter's step response to its control input
+	double efc_step_s;
+	double efc_step_V;
+
+	double lock_threshold;      // |y| below this counts as locked
+	double lock_hold_s;         // ... continuously for this long
+
+	FILE *trace;                // optional per-second CSV trace
+	uint32_t trace_decimation;
+
+	// optional hook after every simulated second, non-zero ends the run
+	int (*on_second)(double t_s, void *ctx);
+	void *ctx;
+} sim_config_t;
+
+typedef struct {
+	double seconds;
+	double lock_time_s;         // -1 if the loop never locked
+	double adev[SIM_ADEV_TAUS]; // from lock (or mid run) to the end, -1 if n/a
+	double holdover_error_s;    // max |time error change| over the outage
+	double final_y;
+	double final_time_error_s;
+	float final_volt;
+	double track_rms_cnt;       // rms of the filter's count excess per second
+	                            // against the true one, over all steps
+	double step_peak_cnt;       // ... largest |error| after the EFC step
+	double step_mean_cnt;       // ... mean and rms over SIM_STEP_WINDOW_S
+	double step_rms_cnt;
+
+	uint32_t steps;             // controller_step() calls
+	uint32_t outliers;
+	uint32_t reacqs;            // filter re-seeds after a run of outliers
+	uint32_t gap_seconds;       // filter predictions across missed pulses
+	uint32_t glitches;          // intervals held back as glitch pulses
+	uint32_t pulses, dropped, extra;
+	uint32_t sw_reads;          // edges counted without a usable TIM1 latch
+	uint32_t overruns;          // captures dropped on a full ring
+	uint32_t backlog_max;       // most captures waiting at once
+	double read_latency_us;     // PPS edge to the counter read, mean
+	double read_latency_max_us; // ... and worst case (TIM5 measured)
+
+	double wall_time_s;
+} sim_result_t;
+
+extern const double sim_adev_tau_s[SIM_ADEV_TAUS];
+
+void sim_config_defaults(sim_config_t *cfg);
+
+// Returns 0 on success, -1 if the run could not be set up.
+int sim_run(const sim_config_t *cfg, sim_result_t *res);
+
+#endif /* SIM_GPSDO_SIM_H_ */
@@ -0,0 +1,303 @@
+/*
+ * gpsdo_sim_main.c
+ *
+ *  Command line front end of the closed-loop simulator.
+ *
+ *  usage: gpsdo_sim [options]   (gpsdo_sim -h lists them)
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "gpsdo_sim.h"
+#include "controller.h"
+#include "filter.h"
+#include "filter_cascade.h"
+#include "pps.h"
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+enum {
+	OPT_DAYS = 256,
+	OPT_SECONDS,
+	OPT_SEED,
+	OPT_OPEN_LOOP,
+	OPT_EFC_STEP,
+	OPT_Y0,
+	OPT_WFM,
+	OPT_FFM,
+	OPT_RWFM,
+	OPT_AGING,
+	OPT_TEMPCO,
+	OPT_TEMP_AMP,
+	OPT_TEMP_PERIOD,
+	OPT_EFC_SCALE,
+	OPT_JITTER,
+	OPT_SAWTOOTH,
+	OPT_DROP,
+	OPT_EXTRA,
+	OPT_OUTAGE_START,
+	OPT_OUTAGE_LEN,
+	OPT_PHASE_STEP,
+	OPT_ISR_LATENCY,
+	OPT_ISR_TAIL,
+	OPT_LATCH,
+	OPT_LATCH_NOISE,
+	OPT_LATE_PROB,
+	OPT_LOCK_THRESHOLD,
+	OPT_LOCK_HOLD,
+	OPT_TRACE,
+	OPT_DECIMATE,
+	OPT_IMM,
+	OPT_STEADY_STATE,
+	OPT_STEER_STAGE,
+	OPT_NO_CONTROL_INPUT,
+	OPT_INIT_SAMPLES,
+};
+
+static const struct option long_options[] = {
+	{ "days", required_argument, NULL, OPT_DAYS },
+	{ "seconds", required_argument, NULL, OPT_SECONDS },
+	{ "seed", required_argument, NULL, OPT_SEED },
+	{ "open-loop", no_argument, NULL, OPT_OPEN_LOOP },
+	{ "efc-step", required_argument, NULL, OPT_EFC_STEP },
+	{ "y0", required_argument, NULL, OPT_Y0 },
+	{ "wfm", required_argument, NULL, OPT_WFM },
+	{ "ffm", required_argument, NULL, OPT_FFM },
+	{ "rwfm", required_argument, NULL, OPT_RWFM },
+	{ "aging", required_argument, NULL, OPT_AGING },
+	{ "tempco", required_argument, NULL, OPT_TEMPCO },
+	{ "temp-amp", required_argument, NULL, OPT_TEMP_AMP },
+	{ "temp-period", required_argument, NULL, OPT_TEMP_PERIOD },
+	{ "efc-scale", required_argument, NULL, OPT_EFC_SCALE },
+	{ "jitter", required_argument, NULL, OPT_JITTER },
+	{ "sawtooth", required_argument, NULL, OPT_SAWTOOTH },
+	{ "drop", required_argument, NULL, OPT_DROP },
+	{ "extra", required_argument, NULL, OPT_EXTRA },
+	{ "outage-start", required_argument, NULL, OPT_OUTAGE_START },
+	{ "outage-len", required_argument, NULL, OPT_OUTAGE_LEN },
+	{ "phase-step", required_argument, NULL, OPT_PHASE_STEP },
+	{ "isr-latency", required_argument, NULL, OPT_ISR_LATENCY },
+	{ "isr-tail", required_argument, NULL, OPT_ISR_TAIL },
+	{ "latch", no_argument, NULL, OPT_LATCH },
+	{ "latch-noise", required_argument, NULL, OPT_LATCH_NOISE },
+	{ "late-prob", required_argument, NULL, OPT_LATE_PROB },
+	{ "lock-threshold", required_argument, NULL, OPT_LOCK_THRESHOLD },
+	{ "lock-hold", required_argument, NULL, OPT_LOCK_HOLD },
+	{ "trace", required_argument, NULL, OPT_TRACE },
+	{ "decimate", required_argument, NULL, OPT_DECIMATE },
+	{ "imm", no_argument, NULL, OPT_IMM },
+	{ "steady-state", no_argument, NULL, OPT_STEADY_STATE },
+	{ "steer-stage", required_argument, NULL, OPT_STEER_STAGE },
+	{ "no-control-input", no_argument, NULL, OPT_NO_CONTROL_INPUT },
+	{ "init-samples", required_argument, NULL, OPT_INIT_SAMPLES },
+	{ "help", no_argument, NULL, 'h' },
+	{ NULL, 0, NULL, 0 },
+};
+
+static void usage(const char *prog, const sim_config_t *d) {
+	fprintf(stderr,
+			"usage: %s [options]\n"
+			"  --days D / --seconds S   simulated time (default %.0f s)\n"
+			"  --seed N                 random seed (default %llu)\n"
+			"  --open-loop              do not write the DAC\n"
+			"  --efc-step S:V           open loop, step the EFC by V volts\n"
+			"                           at S seconds\n"
+			" OCXO (fractional frequency):\n"
+			"  --y0 Y                   initial offset at V_Mid (%.1e)\n"
+			"  --wfm A                  white FM, ADEV at 1 s (%.1e)\n"
+			"  --ffm A                  flicker FM floor (%.1e)\n"
+			"  --rwfm S                 random walk FM step per s (%.1e)\n"
+			"  --aging A                aging per day (%.1e)\n"
+			"  --tempco C               per degC (%.1e)\n"
+			"  --temp-amp C             ambient swing in degC (%.1f)\n"
+			"  --temp-period S          ambient swing period (%.0f s)\n"
+			"  --efc-scale K            EFC gain / Ku_HzDV (%.2f)\n"
+			" PPS:\n"
+			"  --jitter S               rms jitter (%.1e s)\n"
+			"  --sawtooth S             receiver quantisation (%.1e s)\n"
+			"  --drop P                 missing pulse probability (%.1e)\n"
+			"  --extra P                glitch pulse probability (%.1e)\n"
+			"  --outage-start S --outage-len S   PPS outage (holdover)\n"
+			"  --phase-step S:D         PPS moves by D s (-1 ... 1) at S s\n"
+			"                           (receiver restart)\n"
+			" MCU:\n"
+			"  --isr-latency S          PPS edge to the counter read (%.1e s)\n"
+			"  --isr-tail S             ... plus exponential, mean (%.1e s)\n"
+			"  --latch                  PA10 wired: TIM1 CH3 latches the\n"
+			"                           count (PPS_LATCH build only)\n"
+			"  --latch-noise P          the latch holds a noise edge (%.1e)\n"
+			"  --late-prob P            controllerTask held up past an edge\n"
+			"                           (%.1e)\n"
+			" Filter:\n"
+			"  --imm                    clear sky/degraded/jammed IMM filter\n"
+			"  --steady-state           constant DARE gain once K converged\n"
+			"  --steer-stage N          steer from the 10/100/1000 s cascade\n"
+			"                           stage N (1..3, default 0: 1 s filter)\n"
+			"  --no-control-input       do not predict the DAC steps\n"
+			"  --init-samples N         least-squares start over N samples\n"
+			"                           (0: from X = 0)\n"
+			" Metrics and output:\n"
+			"  --lock-threshold Y       |y| counted as locked (%.1e)\n"
+			"  --lock-hold S            ... for at least (%.0f s)\n"
+			"  --trace FILE             per-second CSV trace\n"
+			"  --decimate N             trace every Nth second\n", prog,
+			d->duration_s, (unsigned long long) d->seed, d->ocxo.y0,
+			d->ocxo.wfm_adev, d->ocxo.ffm_adev, d->ocxo.rwfm_step,
+			d->ocxo.aging_per_day, d->ocxo.tempco_per_C, d->ocxo.temp_amp_C,
+			d->ocxo.temp_period_s, d->ocxo.efc_gain_scale, d->pps.jitter_s,
+			d->pps.sawtooth_s, d->pps.drop_prob, d->pps.extra_prob,
+			d->isr_latency_s, d->isr_tail_s, d->latch_noise_prob, d->late_prob,
+			d->lock_threshold, d->lock_hold_s);
+}
+
+int main(int argc, char **argv) {
+	sim_config_t cfg;
+	const char *trace_path = NULL;
+	filter_config_t filter_cfg;
+	controller_config_t ctl_cfg;
+	int opt;
+
+	sim_config_defaults(&cfg);
+	filter_get_config(&filter_cfg);
+	controller_get_config(&ctl_cfg);
+
+	while ((opt = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+		double v = optarg ? strtod(optarg, NULL) : 0.0;
+
+		switch (opt) {
+		case OPT_DAYS:         cfg.duration_s = v * 86400.0; break;
+		case OPT_SECONDS:      cfg.duration_s = v; break;
+		case OPT_SEED:         cfg.seed = strtoull(optarg, NULL, 0); break;
+		case OPT_OPEN_LOOP:    cfg.open_loop = 1; break;
+		case OPT_EFC_STEP:
+			if (sscanf(optarg, "%lf:%lf", &cfg.efc_step_s, &cfg.efc_step_V)
+					!= 2) {
+				fprintf(stderr, "--efc-step takes S:V\n");
+				return 2;
+			}
+			cfg.open_loop = 1;
+			break;
+		case OPT_Y0:           cfg.ocxo.y0 = v; break;
+		case OPT_WFM:          cfg.ocxo.wfm_adev = v; break;
+		case OPT_FFM:          cfg.ocxo.ffm_adev = v; break;
+		case OPT_RWFM:         cfg.ocxo.rwfm_step = v; break;
+		case OPT_AGING:        cfg.ocxo.aging_per_day = v; break;
+		case OPT_TEMPCO:       cfg.ocxo.tempco_per_C = v; break;
+		case OPT_TEMP_AMP:     cfg.ocxo.temp_amp_C = v; break;
+		case OPT_TEMP_PERIOD:  cfg.ocxo.temp_period_s = v; break;
+		case OPT_EFC_SCALE:    cfg.ocxo.efc_gain_scale = v; break;
+		case OPT_JITTER:       cfg.pps.jitter_s = v; break;
+		case OPT_SAWTOOTH:     cfg.pps.sawtooth_s = v; break;
+		case OPT_DROP:         cfg.pps.drop_prob = v; break;
+		case OPT_EXTRA:        cfg.pps.extra_prob = v; break;
+		case OPT_OUTAGE_START: cfg.pps.outage_start_s = v; break;
+		case OPT_OUTAGE_LEN:   cfg.pps.outage_len_s = v; break;
+		case OPT_PHASE_STEP:
+			if (sscanf(optarg, "%lf:%lf", &cfg.pps.phase_step_at_s,
+					&cfg.pps.phase_step_s) != 2
+					|| fabs(cfg.pps.phase_step_s) >= 1.0) {
+				fprintf(stderr, "--phase-step takes S:D, |D| < 1\n");
+				return 2;
+			}
+			break;
+		case OPT_ISR_LATENCY:  cfg.isr_latency_s = v; break;
+		case OPT_ISR_TAIL:     cfg.isr_tail_s = v; break;
+		case OPT_LATCH:
+			if (!PPS_LATCH) {
+				fprintf(stderr, "--latch needs a PPS_LATCH build "
+						"(-DGPSDO_PPS_LATCH=ON)\n");
+				return 2;
+			}
+			cfg.latch = 1;
+			break;
+		case OPT_LATCH_NOISE:  cfg.latch_noise_prob = v; break;
+		case OPT_LATE_PROB:    cfg.late_prob = v; break;
+		case OPT_LOCK_THRESHOLD: cfg.lock_threshold = v; break;
+		case OPT_LOCK_HOLD:    cfg.lock_hold_s = v; break;
+		case OPT_TRACE:        trace_path = optarg; break;
+		case OPT_DECIMATE:     cfg.trace_decimation = (uint32_t) v; break;
+		case OPT_IMM:          filter_cfg.imm = true; break;
+		case OPT_STEADY_STATE: filter_cfg.steady_state = true; break;
+		case OPT_STEER_STAGE:  ctl_cfg.steer_stage = (uint8_t) v; break;
+		case OPT_NO_CONTROL_INPUT: filter_cfg.control_input = false; break;
+		case OPT_INIT_SAMPLES: filter_cfg.init_samples = (uint16_t) v; break;
+		default: {
+			sim_config_t d;
+			sim_config_defaults(&d);
+			usage(argv[0], &d);
+			return opt == 'h' ? 0 : 2;
+		}
+		}
+	}
+
+	if (cfg.duration_s < 1.0) {
+		fprintf(stderr, "duration must be at least 1 s\n");
+		return 2;
+	}
+
+	if (trace_path) {
+		cfg.trace = fopen(trace_path, "w");
+		if (!cfg.trace) {
+			perror(trace_path);
+			return 1;
+		}
+	}
+
+	if (ctl_cfg.steer_stage > FILTER_CASCADE_STAGES) {
+		fprintf(stderr, "steer stage must be 0..%d\n", FILTER_CASCADE_STAGES);
+		return 2;
+	}
+
+	filter_set_config(&filter_cfg);
+	controller_set_config(&ctl_cfg);
+
+	sim_result_t res;
+	int rc = sim_run(&cfg, &res);
+
+	if (cfg.trace)
+		fclose(cfg.trace);
+
+	if (rc != 0) {
+		fprintf(stderr, "simulation failed\n");
+		return 1;
+	}
+
+	printf("simulated %.0f s (%.2f days) in %.2f s (%.0fx real time)\n",
+			res.seconds, res.seconds / 86400.0, res.wall_time_s,
+			res.wall_time_s > 0.0 ? res.seconds / res.wall_time_s : 0.0);
+	printf("pps: %u pulses, %u dropped, %u extra; %u controller steps, "
+			"%u outliers, %u reacquisitions\n", res.pulses, res.dropped,
+			res.extra, res.steps, res.outliers, res.reacqs);
+	printf("gaps: %u s predicted across missed pulses, %u glitch intervals\n",
+			res.gap_seconds, res.glitches);
+	printf("capture: %u of %u edges from the software read, read latency "
+			"%.2f us mean, %.2f us max\n", res.sw_reads, res.pulses,
+			res.read_latency_us, res.read_latency_max_us);
+	printf("ring: %u captures dropped, at most %u waiting\n", res.overruns,
+			res.backlog_max);
+	if (res.lock_time_s >= 0.0)
+		printf("lock: %.0f s (|y| < %.1e for %.0f s)\n", res.lock_time_s,
+				cfg.lock_threshold, cfg.lock_hold_s);
+	else
+		printf("lock: not reached (|y| < %.1e for %.0f s)\n",
+				cfg.lock_threshold, cfg.lock_hold_s);
+	for (int i = 0; i < SIM_ADEV_TAUS; i++)
+		printf("adev(%4.0f s): %.3e\n", sim_adev_tau_s[i], res.adev[i]);
+	if (cfg.pps.outage_len_s > 0.0)
+		printf("holdover: %.3e s max time error over %.0f s outage\n",
+				res.holdover_error_s, cfg.pps.outage_len_s);
+	printf("tracking: %.4f cnt rms filter vs true count excess per second\n",
+			res.track_rms_cnt);
+	if (cfg.efc_step_V != 0.0)
+		printf("step: %+.3f V at %.0f s, error %.4f cnt peak, %+.4f cnt mean, "
+				"%.4f cnt rms over %d s\n", cfg.efc_step_V, cfg.efc_step_s,
+				res.step_peak_cnt, res.step_mean_cnt, res.step_rms_cnt,
+				SIM_STEP_WINDOW_S);
+	printf("final: y %.3e, time error %.3e s, vctrl %.4f V\n", res.final_y,
+			res.final_time_error_s, res.final_volt);
+
+	return 0;
+}
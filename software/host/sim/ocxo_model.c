@@ -0,0 +1,82 @@
+/*
+ * ocxo_model.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "ocxo_model.h"
+#include "gpsdo_config.h"
+
+#include <math.h>
+#include <string.h>
+
+void ocxo_init(ocxo_t *o, const ocxo_params_t *p, sim_rng_t *rng) {
+	memset(o, 0, sizeof(*o));
+	o->p = *p;
+	o->rng = rng;
+
+	// Equal variance per decade approximates a 1/f spectrum between the
+	// shortest and the longest pole.
+	double tau = 1.0;
+	for (int i = 0; i < OCXO_FLICKER_POLES; i++) {
+		o->ff_rho[i] = exp(-1.0 / tau);
+		o->ff_sig[i] = p->ffm_adev * sqrt(1.0 - o->ff_rho[i] * o->ff_rho[i]);
+		o->y_ff[i] = p->ffm_adev * sim_rng_gauss(rng);
+		tau *= 10.0;
+	}
+
+	// random start phase of the divider
+	o->count = (uint64_t) (sim_rng_uniform(rng) * 4294967296.0);
+	o->count_frac = sim_rng_uniform(rng);
+	o->ref_count = (int64_t) o->count;
+	o->ref_frac = o->count_frac;
+}
+
+double ocxo_begin_second(ocxo_t *o, float efc_V) {
+	const ocxo_params_t *p = &o->p;
+
+	double y_ff = 0.0;
+	for (int i = 0; i < OCXO_FLICKER_POLES; i++) {
+		o->y_ff[i] = o->ff_rho[i] * o->y_ff[i]
+				+ o->ff_sig[i] * sim_rng_gauss(o->rng);
+		y_ff += o->y_ff[i];
+	}
+
+	o->y_rw += p->rwfm_step * sim_rng_gauss(o->rng);
+
+	double y_age = p->aging_per_day * o->t_s / 86400.0;
+	o->temp_C = OCXO_TEMP_MEAN_C;
+	if (p->temp_period_s > 0.0)
+		o->temp_C += p->temp_amp_C
+				* sin(2.0 * M_PI * o->t_s / p->temp_period_s);
+	double y_temp = p->tempco_per_C * (o->temp_C - OCXO_TEMP_MEAN_C);
+
+	double y_efc = p->efc_gain_scale * Ku_HzDV * ((double) efc_V - V_Mid)
+			/ F_OSC_HZ;
+
+	o->y = p->y0 + p->wfm_adev * sim_rng_gauss(o->rng) + y_ff + o->y_rw
+			+ y_age + y_temp + y_efc;
+	o->count_rate = EXPECTED_CTR * (1.0 + o->y);
+
+	return o->y;
+}
+
+uint64_t ocxo_count_at(const ocxo_t *o, double offset_s) {
+	double c = o->count_frac + o->count_rate * offset_s;
+	return o->count + (int64_t) floor(c);
+}
+
+void ocxo_end_second(ocxo_t *o) {
+	double c = o->count_frac + o->count_rate;
+	double whole = floor(c);
+
+	o->count += (uint64_t) whole;
+	o->count_frac = c - whole;
+	o->t_s += 1.0;
+}
+
+double ocxo_time_error(const ocxo_t *o) {
+	int64_t elapsed = (int64_t) o->count - o->ref_count
+			- (int64_t) llround(o->t_s * EXPECTED_CTR);
+	return ((double) elapsed + (o->count_frac - o->ref_frac)) / EXPECTED_CTR;
+}
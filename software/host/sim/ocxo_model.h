@@ -0,0 +1,70 @@
+/*
+ * ocxo_model.h
+ *
+ *  OCXO frequency model in fractional frequency y = df/f:
+ *  white FM, flicker FM (sum of first order processes spaced one decade
+ *  apart), random walk FM, linear aging, temperature coefficient and the
+ *  EFC tuning gain. The divided counter phase (TIM1/TIM2 counts) is
+ *  integrated as whole counts plus a fractional residual.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SIM_OCXO_MODEL_H_
+#define SIM_OCXO_MODEL_H_
+
+#include "sim_rng.h"
+
+#include <stdint.h>
+
+#define OCXO_FLICKER_POLES 6    // tau = 1 s ... 100000 s
+#define OCXO_TEMP_MEAN_C   25.0 // ambient the temperature swings around
+
+typedef struct {
+	double y0;              // initial fractional offset at V_Mid
+	double wfm_adev;        // white FM, ADEV at 1 s
+	double ffm_adev;        // flicker FM floor (approximate)
+	double rwfm_step;       // random walk FM, sigma of y step per second
+	double aging_per_day;   // fractional frequency change per day
+	double tempco_per_C;    // fractional frequency per degC
+	double temp_amp_C;      // ambient swing amplitude
+	double temp_period_s;   // ambient swing period
+	double efc_gain_scale;  // actual EFC gain relative to Ku_HzDV
+} ocxo_params_t;
+
+typedef struct {
+	ocxo_params_t p;
+	sim_rng_t *rng;
+
+	double t_s;
+	double y;               // fractional frequency of the current second
+	double temp_C;          // ambient temperature of the current second
+	double y_rw;
+	double y_ff[OCXO_FLICKER_POLES];
+	double ff_rho[OCXO_FLICKER_POLES];
+	double ff_sig[OCXO_FLICKER_POLES];
+
+	uint64_t count;         // divided counter phase, whole counts
+	double count_frac;      // and fractional residual [0, 1)
+	double count_rate;      // counts per second of the current second
+
+	int64_t ref_count;      // counter phase at t = 0 (time error reference)
+	double ref_frac;
+} ocxo_t;
+
+void ocxo_init(ocxo_t *o, const ocxo_params_t *p, sim_rng_t *rng);
+
+// Starts the next one second interval with the given EFC voltage and
+// returns its fractional frequency.
+double ocxo_begin_second(ocxo_t *o, float efc_V);
+
+// Counter value at offset_s seconds from the start of the current second
+uint64_t ocxo_count_at(const ocxo_t *o, double offset_s);
+
+void ocxo_end_second(ocxo_t *o);
+
+// Time error of the OCXO against ideal time at the start of the current
+// second, in seconds.
+double ocxo_time_error(const ocxo_t *o);
+
+#endif /* SIM_OCXO_MODEL_H_ */
@@ -0,0 +1,70 @@
+/*
+ * pps_model.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "pps_model.h"
+
+#include <math.h>
+#include <string.h>
+
+void pps_model_init(pps_model_t *m, const pps_params_t *p, sim_rng_t *rng) {
+	memset(m, 0, sizeof(*m));
+	m->p = *p;
+	m->rng = rng;
+	m->saw_phase = sim_rng_uniform(rng);
+}
+
+int pps_model_in_outage(const pps_model_t *m, double t_s) {
+	return t_s >= m->p.outage_start_s
+			&& t_s < m->p.outage_start_s + m->p.outage_len_s;
+}
+
+int pps_model_edges(pps_model_t *m, double t_s, double *offset_s) {
+	const pps_params_t *p = &m->p;
+	int n = 0;
+
+	// receiver clock walks against GNSS time, the PPS snaps to its edges
+	m->saw_phase += p->sawtooth_rate + 0.01 * sim_rng_gauss(m->rng);
+	m->saw_phase -= floor(m->saw_phase);
+
+	if (pps_model_in_outage(m, t_s))
+		return 0;
+
+	// A phase step back moves the edge of phase_step_at_s into the second
+	// before, after that second's own edge: one short interval, then
+	// whole seconds again
+	double shift = 0.0;
+	int keep = 0;
+	if (p->phase_step_s > 0.0 && t_s >= p->phase_step_at_s)
+		shift = p->phase_step_s;
+	else if (p->phase_step_s < 0.0 && t_s >= p->phase_step_at_s - 1.0) {
+		shift = 1.0 + p->phase_step_s;
+		keep = t_s < p->phase_step_at_s;
+	}
+
+	if (sim_rng_uniform(m->rng) < p->drop_prob)
+		m->dropped++;
+	else {
+		double edge = (m->saw_phase - 0.5) * p->sawtooth_s
+				+ p->jitter_s * sim_rng_gauss(m->rng);
+		if (keep) {
+			offset_s[n++] = edge;
+			m->pulses++;
+		}
+		offset_s[n++] = edge + shift;
+		m->pulses++;
+	}
+
+	if (sim_rng_uniform(m->rng) < p->extra_prob) {
+		double edge = 0.05 + 0.9 * sim_rng_uniform(m->rng);
+		int i = n++;
+		for (; i > 0 && offset_s[i - 1] > edge; i--)
+			offset_s[i] = offset_s[i - 1];
+		offset_s[i] = edge;
+		m->extra++;
+	}
+
+	return n;
+}
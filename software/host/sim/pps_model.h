@@ -0,0 +1,49 @@
+/*
+ * pps_model.h
+ *
+ *  GNSS receiver PPS: quantisation sawtooth of the receiver clock, white
+ *  jitter, randomly dropped and extra (glitch) pulses, a configurable
+ *  outage window for holdover tests and a PPS phase step (receiver
+ *  restart).
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SIM_PPS_MODEL_H_
+#define SIM_PPS_MODEL_H_
+
+#include "sim_rng.h"
+
+#define PPS_MODEL_MAX_EDGES 3
+
+typedef struct {
+	double jitter_s;        // white timing jitter (rms)
+	double sawtooth_s;      // receiver clock period (sawtooth peak-peak)
+	double sawtooth_rate;   // receiver clock drift, sawtooth periods per s
+	double drop_prob;       // probability a pulse is missing
+	double extra_prob;      // probability of an additional glitch pulse
+	double outage_start_s;  // no pulses in [start, start + len)
+	double outage_len_s;
+	double phase_step_at_s; // the PPS moves by phase_step_s (-1 ... 1, 0:
+	double phase_step_s;    // none) from this second on
+} pps_params_t;
+
+typedef struct {
+	pps_params_t p;
+	sim_rng_t *rng;
+	double saw_phase;
+
+	uint32_t pulses;
+	uint32_t dropped;
+	uint32_t extra;
+} pps_model_t;
+
+void pps_model_init(pps_model_t *m, const pps_params_t *p, sim_rng_t *rng);
+
+// Edges belonging to second t_s as offsets from t_s, in time order.
+// Returns the number of edges written to offset_s (0 ... PPS_MODEL_MAX_EDGES).
+int pps_model_edges(pps_model_t *m, double t_s, double *offset_s);
+
+int pps_model_in_outage(const pps_model_t *m, double t_s);
+
+#endif /* SIM_PPS_MODEL_H_ */
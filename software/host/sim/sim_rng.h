@@ -0,0 +1,77 @@
+/*
+ * sim_rng.h
+ *
+ *  Seeded xoshiro256** generator with uniform and gaussian draws, so
+ *  simulator runs are reproducible from a single 64 bit seed.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SIM_SIM_RNG_H_
+#define SIM_SIM_RNG_H_
+
+#include <math.h>
+#include <stdint.h>
+
+typedef struct {
+	uint64_t s[4];
+	double spare;
+	int has_spare;
+} sim_rng_t;
+
+static inline uint64_t sim_rng_rotl(uint64_t x, int k) {
+	return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t sim_rng_next(sim_rng_t *rng) {
+	uint64_t *s = rng->s;
+	uint64_t result = sim_rng_rotl(s[1] * 5, 7) * 9;
+	uint64_t t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = sim_rng_rotl(s[3], 45);
+
+	return result;
+}
+
+static inline void sim_rng_seed(sim_rng_t *rng, uint64_t seed) {
+	// splitmix64 expansion of the seed
+	for (int i = 0; i < 4; i++) {
+		uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		rng->s[i] = z ^ (z >> 31);
+	}
+	rng->has_spare = 0;
+}
+
+// uniform in [0, 1)
+static inline double sim_rng_uniform(sim_rng_t *rng) {
+	return (double) (sim_rng_next(rng) >> 11) * 0x1.0p-53;
+}
+
+// standard normal (Marsaglia polar method)
+static inline double sim_rng_gauss(sim_rng_t *rng) {
+	if (rng->has_spare) {
+		rng->has_spare = 0;
+		return rng->spare;
+	}
+
+	double u, v, s;
+	do {
+		u = 2.0 * sim_rng_uniform(rng) - 1.0;
+		v = 2.0 * sim_rng_uniform(rng) - 1.0;
+		s = u * u + v * v;
+	} while (s >= 1.0 || s == 0.0);
+
+	double m = sqrt(-2.0 * log(s) / s);
+	rng->spare = v * m;
+	rng->has_spare = 1;
+	return u * m;
+}
+
+#endif /* SIM_SIM_RNG_H_ */
@@ -0,0 +1,429 @@
+/*
+ * gpsdo_sweep.c
+ *
+ *  Parameter sweep over the filter and loop tunables. Every point of the
+ *  grid is an independent closed-loop gpsdo_sim run; the runs are spread
+ *  over all cores by the work-stealing pool and the scores are written to
+ *  a CSV table.
+ *
+ *  A sweep parameter is a single value, a list "a,b,c" or a range
+ *  "min:max:n[:log]".
+ *
+ *  usage: gpsdo_sweep [options] -o results.csv   (gpsdo_sweep -h)
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "work_pool.h"
+#include "gpsdo_sim.h"
+#include "filter.h"
+#include "controller.h"
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SWEEP_MAX_VALUES 256
+
+typedef enum {
+	P_Q,
+	P_SIGMA_PHASE,
+	P_MAHAL,
+	P_KP,
+	P_KI,
+	P_ALPHA_PHASE,
+	P_ALPHA_FREQ,
+	P_ALPHA_DRIFT,
+	P_CONTROL_INPUT,
+	P_COUNT
+} sweep_param_id_t;
+
+typedef struct {
+	const char *name;
+	double values[SWEEP_MAX_VALUES];
+	uint32_t n;
+} sweep_param_t;
+
+typedef struct {
+	int ok;
+	double lock_time_s;
+	double adev[SIM_ADEV_TAUS];
+	uint32_t outliers;
+	double track_rms_cnt;
+	double wall_time_s;
+} sweep_result_t;
+
+typedef struct {
+	sweep_param_t param[P_COUNT];
+	uint32_t seeds;
+	uint64_t seed0;
+	sim_config_t sim;
+	sweep_result_t *results;    // shared with the workers
+} sweep_t;
+
+typedef enum {
+	SORT_LOCK,
+	SORT_ADEV1,
+	SORT_ADEV10,
+	SORT_ADEV100,
+	SORT_ADEV1000,
+	SORT_OUTLIERS
+} sweep_sort_t;
+
+static const char *sort_names[] = { "lock", "adev1", "adev10", "adev100",
+		"adev1000", "outliers" };
+
+// Parses "v", "a,b,c" or "min:max:n[:log]"
+static int parse_values(const char *spec, sweep_param_t *p) {
+	char *end;
+
+	if (strchr(spec, ':')) {
+		double lo = strtod(spec, &end);
+		if (*end != ':')
+			return -1;
+		double hi = strtod(end + 1, &end);
+		if (*end != ':')
+			return -1;
+		long n = strtol(end + 1, &end, 10);
+		int log_scale = (strcmp(end, ":log") == 0);
+		if ((*end && !log_scale) || n < 1 || n > SWEEP_MAX_VALUES)
+			return -1;
+		if (log_scale && (lo <= 0.0 || hi <= 0.0))
+			return -1;
+
+		p->n = (uint32_t) n;
+		for (long i = 0; i < n; i++) {
+			double f = (n > 1) ? (double) i / (double) (n - 1) : 0.0;
+			p->values[i] = log_scale ?
+					lo * pow(hi / lo, f) : lo + (hi - lo) * f;
+		}
+		return 0;
+	}
+
+	p->n = 0;
+	const char *s = spec;
+	while (*s) {
+		if (p->n >= SWEEP_MAX_VALUES)
+			return -1;
+		p->values[p->n++] = strtod(s, &end);
+		if (end == s)
+			return -1;
+		s = (*end == ',') ? end + 1 : end;
+		if (*end && *end != ',')
+			return -1;
+	}
+	return p->n ? 0 : -1;
+}
+
+static uint32_t sweep_points(const sweep_t *sw) {
+	uint64_t n = 1;
+	for (int i = 0; i < P_COUNT; i++)
+		n *= sw->param[i].n;
+	return (uint32_t) n;
+}
+
+// job index -> parameter indices (mixed radix, seed fastest)
+static void job_decode(const sweep_t *sw, uint32_t job, uint32_t idx[P_COUNT],
+		uint32_t *seed) {
+	*seed = job % sw->seeds;
+	job /= sw->seeds;
+	for (int i = P_COUNT - 1; i >= 0; i--) {
+		idx[i] = job % sw->param[i].n;
+		job /= sw->param[i].n;
+	}
+}
+
+static double job_value(const sweep_t *sw, const uint32_t idx[P_COUNT],
+		sweep_param_id_t p) {
+	return sw->param[p].values[idx[p]];
+}
+
+static void sweep_job(uint32_t job, int worker, void *ctx) {
+	sweep_t *sw = ctx;
+	uint32_t idx[P_COUNT], seed;
+	(void) worker;
+
+	job_decode(sw, job, idx, &seed);
+
+	filter_config_t fc;
+	filter_get_config(&fc);
+	fc.q = (float) job_value(sw, idx, P_Q);
+	fc.sigma_phase = (float) job_value(sw, idx, P_SIGMA_PHASE);
+	fc.mahal_threshold = (float) job_value(sw, idx, P_MAHAL);
+	fc.control_input = job_value(sw, idx, P_CONTROL_INPUT) != 0.0;
+	controller_config_t cc;
+	controller_get_config(&cc);
+	cc.Kp = (float) job_value(sw, idx, P_KP);
+	cc.Ki = (float) job_value(sw, idx, P_KI);
+	cc.alpha_phase = (float) job_value(sw, idx, P_ALPHA_PHASE);
+	cc.alpha_freq = (float) job_value(sw, idx, P_ALPHA_FREQ);
+	cc.alpha_drift = (float) job_value(sw, idx, P_ALPHA_DRIFT);
+
+	filter_set_config(&fc);
+	controller_set_config(&cc);
+
+	sim_config_t cfg = sw->sim;
+	cfg.seed = sw->seed0 + seed;
+
+	sim_result_t res;
+	sweep_result_t *out = &sw->results[job];
+	if (sim_run(&cfg, &res) != 0)
+		return;
+
+	out->lock_time_s = res.lock_time_s;
+	memcpy(out->adev, res.adev, sizeof(out->adev));
+	out->outliers = res.outliers;
+	out->track_rms_cnt = res.track_rms_cnt;
+	out->wall_time_s = res.wall_time_s;
+	out->ok = 1;
+}
+
+static void sweep_progress(uint32_t done, uint32_t total, uint32_t stolen,
+		void *ctx) {
+	(void) ctx;
+	fprintf(stderr, "\r%u/%u runs (%u stolen)", done, total, stolen);
+	if (done == total)
+		fprintf(stderr, "\n");
+}
+
+// ---- Ranking ----
+
+static const sweep_result_t *sort_results;
+static sweep_sort_t sort_key;
+
+static double sort_value(const sweep_result_t *r) {
+	switch (sort_key) {
+	case SORT_LOCK:
+		return r->lock_time_s < 0.0 ? INFINITY : r->lock_time_s;
+	case SORT_OUTLIERS:
+		return (double) r->outliers;
+	default: {
+		double a = r->adev[sort_key - SORT_ADEV1];
+		return a < 0.0 ? INFINITY : a;
+	}
+	}
+}
+
+static int sort_cmp(const void *a, const void *b) {
+	const sweep_result_t *ra = &sort_results[*(const uint32_t*) a];
+	const sweep_result_t *rb = &sort_results[*(const uint32_t*) b];
+
+	if (ra->ok != rb->ok)
+		return rb->ok - ra->ok;
+
+	double va = sort_value(ra), vb = sort_value(rb);
+	if (va != vb)
+		return va < vb ? -1 : 1;
+
+	// ties (e.g. never locked): better 100 s stability first
+	double aa = ra->adev[2] < 0.0 ? INFINITY : ra->adev[2];
+	double ab = rb->adev[2] < 0.0 ? INFINITY : rb->adev[2];
+	return (aa > ab) - (aa < ab);
+}
+
+static void write_row(FILE *f, const sweep_t *sw, uint32_t job) {
+	uint32_t idx[P_COUNT], seed;
+	const sweep_result_t *r = &sw->results[job];
+
+	job_decode(sw, job, idx, &seed);
+	fprintf(f, "%u", job);
+	for (int i = 0; i < P_COUNT; i++)
+		fprintf(f, ",%.6g", job_value(sw, idx, i));
+	fprintf(f, ",%llu,%d,%.0f", (unsigned long long) (sw->seed0 + seed),
+			r->ok, r->lock_time_s);
+	for (int i = 0; i < SIM_ADEV_TAUS; i++)
+		fprintf(f, ",%.4e", r->adev[i]);
+	fprintf(f, ",%u,%.4f,%.3f\n", r->outliers, r->track_rms_cnt,
+			r->wall_time_s);
+}
+
+static void write_header(FILE *f, const sweep_t *sw) {
+	fprintf(f, "job");
+	for (int i = 0; i < P_COUNT; i++)
+		fprintf(f, ",%s", sw->param[i].name);
+	fprintf(f, ",seed,ok,lock_time_s");
+	for (int i = 0; i < SIM_ADEV_TAUS; i++)
+		fprintf(f, ",adev_%.0fs", sim_adev_tau_s[i]);
+	fprintf(f, ",outliers,track_rms_cnt,wall_time_s\n");
+}
+
+// ---- Command line ----
+
+enum {
+	OPT_DAYS = 256,
+	OPT_SECONDS,
+	OPT_SEED,
+	OPT_SEEDS,
+	OPT_Y0,
+	OPT_JITTER,
+	OPT_DROP,
+	OPT_SORT,
+	OPT_TOP,
+};
+
+static const struct option long_options[] = {
+	{ "q", required_argument, NULL, P_Q },
+	{ "sigma-phase", required_argument, NULL, P_SIGMA_PHASE },
+	{ "mahal", required_argument, NULL, P_MAHAL },
+	{ "kp", required_argument, NULL, P_KP },
+	{ "ki", required_argument, NULL, P_KI },
+	{ "alpha-phase", required_argument, NULL, P_ALPHA_PHASE },
+	{ "alpha-freq", required_argument, NULL, P_ALPHA_FREQ },
+	{ "alpha-drift", required_argument, NULL, P_ALPHA_DRIFT },
+	{ "control-input", required_argument, NULL, P_CONTROL_INPUT },
+	{ "days", required_argument, NULL, OPT_DAYS },
+	{ "seconds", required_argument, NULL, OPT_SECONDS },
+	{ "seed", required_argument, NULL, OPT_SEED },
+	{ "seeds", required_argument, NULL, OPT_SEEDS },
+	{ "y0", required_argument, NULL, OPT_Y0 },
+	{ "jitter", required_argument, NULL, OPT_JITTER },
+	{ "drop", required_argument, NULL, OPT_DROP },
+	{ "sort", required_argument, NULL, OPT_SORT },
+	{ "top", required_argument, NULL, OPT_TOP },
+	{ "help", no_argument, NULL, 'h' },
+	{ NULL, 0, NULL, 0 },
+};
+
+static void usage(const char *prog) {
+	fprintf(stderr,
+			"usage: %s [options] -o results.csv\n"
+			" sweep parameters (V | a,b,c | min:max:n[:log], default: firmware value)\n"
+			"  --q --sigma-phase --mahal --kp --ki\n"
+			"  --alpha-phase --alpha-freq --alpha-drift\n"
+			"  --control-input 0,1      predict the DAC steps in the filter\n"
+			" runs:\n"
+			"  --days D / --seconds S   simulated time per run (default 1 day)\n"
+			"  --seed N --seeds K       K replicates per point, seeds N..N+K-1\n"
+			"  --y0 Y --jitter S --drop P   OCXO/PPS model overrides\n"
+			"  -j N                     worker processes (default: all cores)\n"
+			" output:\n"
+			"  -o FILE                  results table (CSV)\n"
+			"  --sort KEY --top N       summary ranking (lock, adev1, adev10,\n"
+			"                           adev100, adev1000, outliers)\n", prog);
+}
+
+int main(int argc, char **argv) {
+	sweep_t sw = { 0 };
+	const char *out_path = NULL;
+	int workers = work_pool_default_workers();
+	uint32_t top = 10;
+	filter_config_t fc;
+	controller_config_t cc;
+	int opt;
+
+	static const char *names[P_COUNT] = { "q", "sigma_phase", "mahal_threshold",
+			"kp", "ki", "alpha_phase", "alpha_freq", "alpha_drift",
+			"control_input" };
+	filter_get_config(&fc);
+	controller_get_config(&cc);
+	const double defaults[P_COUNT] = { fc.q, fc.sigma_phase,
+			fc.mahal_threshold, cc.Kp, cc.Ki, cc.alpha_phase, cc.alpha_freq,
+			cc.alpha_drift, fc.control_input };
+
+	for (int i = 0; i < P_COUNT; i++) {
+		sw.param[i].name = names[i];
+		sw.param[i].values[0] = defaults[i];
+		sw.param[i].n = 1;
+	}
+	sw.seeds = 1;
+	sw.seed0 = 1;
+	sim_config_defaults(&sw.sim);
+	sort_key = SORT_LOCK;
+
+	while ((opt = getopt_long(argc, argv, "o:j:h", long_options, NULL)) != -1) {
+		if (opt >= 0 && opt < P_COUNT) {
+			if (parse_values(optarg, &sw.param[opt]) != 0) {
+				fprintf(stderr, "bad value list for %s: %s\n",
+						sw.param[opt].name, optarg);
+				return 2;
+			}
+			continue;
+		}
+
+		switch (opt) {
+		case 'o': out_path = optarg; break;
+		case 'j': workers = atoi(optarg); break;
+		case OPT_DAYS: sw.sim.duration_s = strtod(optarg, NULL) * 86400.0; break;
+		case OPT_SECONDS: sw.sim.duration_s = strtod(optarg, NULL); break;
+		case OPT_SEED: sw.seed0 = strtoull(optarg, NULL, 0); break;
+		case OPT_SEEDS: sw.seeds = (uint32_t) atoi(optarg); break;
+		case OPT_Y0: sw.sim.ocxo.y0 = strtod(optarg, NULL); break;
+		case OPT_JITTER: sw.sim.pps.jitter_s = strtod(optarg, NULL); break;
+		case OPT_DROP: sw.sim.pps.drop_prob = strtod(optarg, NULL); break;
+		case OPT_TOP: top = (uint32_t) atoi(optarg); break;
+		case OPT_SORT: {
+			int k;
+			for (k = 0; k <= SORT_OUTLIERS; k++)
+				if (strcmp(optarg, sort_names[k]) == 0)
+					break;
+			if (k > SORT_OUTLIERS) {
+				fprintf(stderr, "unknown sort key %s\n", optarg);
+				return 2;
+			}
+			sort_key = (sweep_sort_t) k;
+			break;
+		}
+		default:
+			usage(argv[0]);
+			return opt == 'h' ? 0 : 2;
+		}
+	}
+
+	if (!out_path || sw.seeds < 1 || sw.sim.duration_s < 1.0) {
+		usage(argv[0]);
+		return 2;
+	}
+
+	uint64_t n_jobs = (uint64_t) sweep_points(&sw) * sw.seeds;
+	if (n_jobs > UINT32_MAX / 2) {
+		fprintf(stderr, "sweep too large (%llu runs)\n",
+				(unsigned long long) n_jobs);
+		return 2;
+	}
+
+	FILE *out = fopen(out_path, "w");
+	if (!out) {
+		perror(out_path);
+		return 1;
+	}
+
+	size_t res_size = n_jobs * sizeof(sweep_result_t);
+	sw.results = work_pool_shared_alloc(res_size);
+	if (!sw.results) {
+		perror("mmap");
+		fclose(out);
+		return 1;
+	}
+
+	fprintf(stderr, "%llu runs of %.0f s on %d workers\n",
+			(unsigned long long) n_jobs, sw.sim.duration_s, workers);
+
+	int rc = work_pool_run((uint32_t) n_jobs, workers, sweep_job,
+			sweep_progress, &sw);
+
+	write_header(out, &sw);
+	for (uint32_t j = 0; j < n_jobs; j++)
+		write_row(out, &sw, j);
+	fclose(out);
+
+	// ranking summary
+	uint32_t *order = malloc(n_jobs * sizeof(*order));
+	if (order) {
+		for (uint32_t j = 0; j < n_jobs; j++)
+			order[j] = j;
+		sort_results = sw.results;
+		qsort(order, n_jobs, sizeof(*order), sort_cmp);
+
+		printf("best %u by %s:\n", top < n_jobs ? top : (uint32_t) n_jobs,
+				sort_names[sort_key]);
+		write_header(stdout, &sw);
+		for (uint32_t j = 0; j < top && j < n_jobs; j++)
+			write_row(stdout, &sw, order[j]);
+		free(order);
+	}
+
+	work_pool_shared_free(sw.results, res_size);
+	return rc ? 1 : 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * work_pool.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "work_pool.h"
+
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+	_Atomic uint64_t range;     // lo | (hi << 32), jobs [lo, hi) still open
+	char pad[56];               // one cache line per worker
+} work_pool_deque_t;
+
+typedef struct {
+	_Atomic uint32_t done;
+	_Atomic uint32_t stolen;
+	work_pool_deque_t deque[];
+} work_pool_shared_t;
+
+#define RANGE(lo, hi)  ((uint64_t) (lo) | ((uint64_t) (hi) << 32))
+#define RANGE_LO(r)    ((uint32_t) (r))
+#define RANGE_HI(r)    ((uint32_t) ((r) >> 32))
+
+void* work_pool_shared_alloc(size_t size) {
+	void *p = mmap(NULL, size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	return (p == MAP_FAILED) ? NULL : p;
+}
+
+void work_pool_shared_free(void *ptr, size_t size) {
+	if (ptr)
+		munmap(ptr, size);
+}
+
+int work_pool_default_workers(void) {
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return (n > 0) ? (int) n : 1;
+}
+
+// owner end: take hi - 1
+static int take_own(work_pool_deque_t *d, uint32_t *job) {
+	uint64_t r = atomic_load(&d->range);
+	while (RANGE_LO(r) < RANGE_HI(r)) {
+		uint64_t next = RANGE(RANGE_LO(r), RANGE_HI(r) - 1);
+		if (atomic_compare_exchange_weak(&d->range, &r, next)) {
+			*job = RANGE_HI(r) - 1;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// thief end: take lo
+static int steal(work_pool_deque_t *d, uint32_t *job) {
+	uint64_t r = atomic_load(&d->range);
+	while (RANGE_LO(r) < RANGE_HI(r)) {
+		uint64_t next = RANGE(RANGE_LO(r) + 1, RANGE_HI(r));
+		if (atomic_compare_exchange_weak(&d->range, &r, next)) {
+			*job = RANGE_LO(r);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static void worker_main(work_pool_shared_t *sh, int self, int n_workers,
+		work_pool_job_fn fn, void *ctx) {
+	uint32_t job;
+
+	for (;;) {
+		if (take_own(&sh->deque[self], &job)) {
+			fn(job, self, ctx);
+			atomic_fetch_add(&sh->done, 1);
+			continue;
+		}
+
+		int found = 0;
+		for (int i = 1; i < n_workers && !found; i++) {
+			if (steal(&sh->deque[(self + i) % n_workers], &job)) {
+				found = 1;
+				atomic_fetch_add(&sh->stolen, 1);
+				fn(job, self, ctx);
+				atomic_fetch_add(&sh->done, 1);
+			}
+		}
+		if (!found)
+			return;
+	}
+}
+
+int work_pool_run(uint32_t n_jobs, int n_workers, work_pool_job_fn fn,
+		work_pool_progress_fn progress, void *ctx) {
+	if (n_workers < 1)
+		n_workers = 1;
+	if ((uint32_t) n_workers > n_jobs)
+		n_workers = n_jobs ? (int) n_jobs : 1;
+
+	size_t sh_size = sizeof(work_pool_shared_t)
+			+ (size_t) n_workers * sizeof(work_pool_deque_t);
+	work_pool_shared_t *sh = work_pool_shared_alloc(sh_size);
+	if (!sh) {
+		perror("mmap");
+		return -1;
+	}
+
+	// initial split: contiguous, equally sized ranges
+	for (int w = 0; w < n_workers; w++) {
+		uint32_t lo = (uint32_t) ((uint64_t) n_jobs * w / n_workers);
+		uint32_t hi = (uint32_t) ((uint64_t) n_jobs * (w + 1) / n_workers);
+		atomic_init(&sh->deque[w].range, RANGE(lo, hi));
+	}
+
+	fflush(NULL);
+	int rc = 0;
+	int running = 0;
+	for (int w = 0; w < n_workers; w++) {
+		pid_t pid = fork();
+		if (pid == 0) {
+			worker_main(sh, w, n_workers, fn, ctx);
+			fflush(NULL);
+			_exit(0);
+		}
+		if (pid < 0) {
+			perror("fork");
+			rc = -1;
+			break;
+		}
+		running++;
+	}
+
+	// workers that did fork steal the jobs of those that did not
+	while (running > 0) {
+		int status;
+		pid_t pid = waitpid(-1, &status, WNOHANG);
+
+		if (pid > 0) {
+			running--;
+			if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+				fprintf(stderr, "worker %d failed (status 0x%x)\n", (int) pid,
+						status);
+				rc = -1;
+			}
+			continue;
+		}
+		if (pid < 0 && errno != EINTR)
+			break;
+
+		if (progress)
+			progress(atomic_load(&sh->done), n_jobs, atomic_load(&sh->stolen),
+					ctx);
+
+		struct timespec ts = { .tv_sec = 1, .tv_nsec = 0 };
+		nanosleep(&ts, NULL);
+	}
+
+	if (progress)
+		progress(atomic_load(&sh->done), n_jobs, atomic_load(&sh->stolen), ctx);
+
+	if (atomic_load(&sh->done) != n_jobs)
+		rc = -1;
+
+	work_pool_shared_free(sh, sh_size);
+	return rc;
+}
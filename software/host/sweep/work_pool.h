@@ -0,0 +1,37 @@
+/*
+ * work_pool.h
+ *
+ *  Work-stealing pool over forked worker processes. The firmware modules
+ *  keep their state in file statics, so every worker is a separate
+ *  process; job ranges and the results live in shared memory.
+ *
+ *  Each worker owns a contiguous range of job indices and takes jobs from
+ *  its end; an idle worker steals from the start of another worker's
+ *  range. Both ends live in one 64 bit word updated by CAS.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SWEEP_WORK_POOL_H_
+#define SWEEP_WORK_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef void (*work_pool_job_fn)(uint32_t job, int worker, void *ctx);
+typedef void (*work_pool_progress_fn)(uint32_t done, uint32_t total,
+		uint32_t stolen, void *ctx);
+
+// Memory visible to all workers and the parent (MAP_SHARED), zeroed.
+void* work_pool_shared_alloc(size_t size);
+void work_pool_shared_free(void *ptr, size_t size);
+
+int work_pool_default_workers(void);
+
+// Runs fn for every job in [0, n_jobs) on n_workers processes. progress
+// (optional) is called in the parent about once per second. Returns 0 if
+// all workers exited cleanly.
+int work_pool_run(uint32_t n_jobs, int n_workers, work_pool_job_fn fn,
+		work_pool_progress_fn progress, void *ctx);
+
+#endif /* SWEEP_WORK_POOL_H_ */
@@ -0,0 +1,94 @@
+/*
+ * cdc_model.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "cdc_model.h"
+#include "hal.h"
+#include "usbd_cdc_if.h"
+#include "usb_device.h"
+
+#include <string.h>
+
+static cdc_model_params_t params;
+static cdc_model_stats_t stats;
+static USBD_CDC_HandleTypeDef hcdc;
+
+static uint64_t now_us = 0;
+static uint64_t done_us = 0;    // end of the transfer in flight
+
+void cdc_model_params_default(cdc_model_params_t *p) {
+	p->packet_size = CDC_DATA_FS_MAX_PACKET_SIZE;
+	p->packets_per_frame = 19;  // 1216 B/frame, the full-speed bulk limit
+	p->frame_us = 1000;
+}
+
+void cdc_model_init(const cdc_model_params_t *p) {
+	params = *p;
+	memset(&stats, 0, sizeof(stats));
+	memset(&hcdc, 0, sizeof(hcdc));
+	now_us = 0;
+	done_us = 0;
+}
+
+uint64_t cdc_model_now_us(void) {
+	return now_us;
+}
+
+void cdc_model_advance(uint64_t t_us) {
+	if (t_us > now_us)
+		now_us = t_us;
+	if (hcdc.TxState && now_us >= done_us)
+		hcdc.TxState = 0;   // USBD_CDC_DataIn() of the last packet
+}
+
+void cdc_model_get_stats(cdc_model_stats_t *dst) {
+	*dst = stats;
+}
+
+// Completion time of n packets queued at now_us, slot by slot per frame
+static uint64_t cdc_model_schedule(uint32_t n) {
+	double slot_us = (double) params.frame_us / params.packets_per_frame;
+	uint64_t frame = now_us / params.frame_us;
+	uint32_t slot = (uint32_t) (((double) (now_us % params.frame_us)
+			+ slot_us - 1e-9) / slot_us);
+
+	while (n > 0) {
+		if (slot >= params.packets_per_frame) {
+			frame++;
+			slot = 0;
+		}
+		uint32_t take = params.packets_per_frame - slot;
+		if (take > n)
+			take = n;
+		slot += take;
+		n -= take;
+	}
+	return frame * params.frame_us + (uint64_t) (slot * slot_us + 0.5);
+}
+
+uint8_t CDC_Transmit_FS(uint8_t *Buf, uint16_t Len) {
+	if (hcdc.TxState != 0) {
+		stats.busy++;
+		return USBD_BUSY;
+	}
+
+	// a transfer ending on a packet boundary is terminated by a ZLP
+	uint32_t packets = Len / params.packet_size + 1;
+
+	hcdc.TxBuffer = Buf;
+	hcdc.TxLength = Len;
+	hcdc.TxState = 1;
+	done_us = cdc_model_schedule(packets);
+
+	stats.transfers++;
+	stats.bytes += Len;
+	stats.packets += packets;
+	return USBD_OK;
+}
+
+void MX_USB_DEVICE_Init(void) {
+	hUsbDeviceFS.dev_state = USBD_STATE_CONFIGURED;
+	hUsbDeviceFS.pClassData = &hcdc;
+}
@@ -0,0 +1,39 @@
+/*
+ * cdc_model.h
+ *
+ *  Full-speed bulk IN endpoint model behind CDC_Transmit_FS(). A transfer
+ *  is split into max-packet-size packets (plus a ZLP when it ends on a
+ *  packet boundary); the host schedules at most packets_per_frame of them
+ *  per 1 ms frame. TxState stays busy until the last packet went out.
+ *
+ *  Time is virtual (microseconds) and only moves in cdc_model_advance().
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef USBTX_CDC_MODEL_H_
+#define USBTX_CDC_MODEL_H_
+
+#include <stdint.h>
+
+typedef struct {
+	uint32_t packet_size;       // bulk max packet size (64 at full speed)
+	uint32_t packets_per_frame; // bulk packets the host fits into a frame
+	uint32_t frame_us;          // USB frame period (1000 at full speed)
+} cdc_model_params_t;
+
+typedef struct {
+	uint64_t transfers;         // accepted CDC_Transmit_FS() calls
+	uint64_t busy;              // calls rejected with USBD_BUSY
+	uint64_t bytes;
+	uint64_t packets;           // including zero length packets
+} cdc_model_stats_t;
+
+void cdc_model_params_default(cdc_model_params_t *p);
+void cdc_model_init(const cdc_model_params_t *p);
+
+uint64_t cdc_model_now_us(void);
+void cdc_model_advance(uint64_t t_us);
+void cdc_model_get_stats(cdc_model_stats_t *dst);
+
+#endif /* USBTX_CDC_MODEL_H_ */
@@ -0,0 +1,327 @@
+/*
+ * gpsdo_usbtx.c
+ *
+ *  Throughput harness for the USB CDC transmit path. The unchanged usbTask
+ *  from Tasks/com_usb/usb.c runs against the full-speed endpoint model in
+ *  cdc_model.c on a virtual clock: vTaskDelay() and the blocking queue set
+ *  select advance time, TxState clears when the modelled transfer ends.
+ *
+ *  Telemetry is produced through the firmware flatbuf_send_* API (or as
+ *  raw frames of a given payload size), either in PPS bursts at --rate or
+ *  saturating the TX queue, and the harness reports what the link carried.
+ *
+ *  usage: gpsdo_usbtx [--mix status,kf_debug] [--rate HZ | --saturate]
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "cdc_model.h"
+#include "usb.h"
+#include "task.h"
+#include "flatbuf_message_builder.h"
+
+#include <getopt.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define USBTX_MAX_MIX   16
+#define USBTX_TICK_US   1000        // configTICK_RATE_HZ = 1000
+
+typedef enum {
+	MSG_STATUS,
+	MSG_KF_DEBUG,
+	MSG_PROFILE,
+	MSG_RAW,                        // synthetic payload of a given size
+} usbtx_msg_t;
+
+static const char *msg_names[] = { "status", "kf_debug", "profile", "raw" };
+
+typedef struct {
+	usbtx_msg_t type;
+	uint16_t raw_len;
+	char label[16];
+
+	uint64_t offered;
+	uint64_t queued;
+	uint64_t dropped_full;          // TX queue full
+	uint64_t dropped_size;          // payload larger than USB_MSG_MAX_SIZE
+} usbtx_item_t;
+
+typedef struct {
+	usbtx_item_t mix[USBTX_MAX_MIX];
+	uint32_t n_mix;
+	double rate_hz;                 // bursts of the whole mix per second
+	int saturate;                   // keep the TX queue full instead
+	double duration_s;
+	cdc_model_params_t cdc;
+
+	// run state
+	uint64_t end_us;
+	uint64_t next_burst_us;
+	uint32_t next_item;             // round robin position when saturating
+	jmp_buf done;
+} usbtx_t;
+
+// usbTask is started by the RTOS on the target
+void usbTask(void *argument);
+
+static usbtx_t *run;
+static KF_DebugSnapshot kf_snapshot;
+static profile_stats_t profile_stats;
+static const pps_stats_t usbtx_pps = { .seq = 86400, .backlog_max = 1 };
+
+static void usbtx_send(usbtx_item_t *it) {
+	UBaseType_t before = uxQueueMessagesWaiting(xUsbTxQueue);
+	int full = before >= USB_TX_QUEUE_LENGTH;
+
+	switch (it->type) {
+	case MSG_STATUS:
+		flatbuf_send_status(0.25f, 1.5e-3f, -2.0e-7f, 2.0f, 2.0f, 45.0f,
+				5000000, NULL, &usbtx_pps);
+		break;
+	case MSG_KF_DEBUG:
+		kf_snapshot.iteration++;
+		flatbuf_send_kf_debug(&kf_snapshot);
+		break;
+	case MSG_PROFILE:
+		flatbuf_send_profile(0, &profile_stats, 96000000);
+		break;
+	case MSG_RAW: {
+		flatbuf_message_t msg = { .magic = FLATBUF_MAGIC, .msg_id = 0,
+				.len = it->raw_len };
+		xQueueSend(xUsbTxQueue, &msg, 0);
+		break;
+	}
+	}
+
+	it->offered++;
+	if (uxQueueMessagesWaiting(xUsbTxQueue) > before)
+		it->queued++;
+	else if (full)
+		it->dropped_full++;
+	else
+		it->dropped_size++;
+}
+
+// Moves virtual time to t_us, producing everything due on the way.
+static void usbtx_advance(uint64_t t_us) {
+	while (!run->saturate && run->next_burst_us <= t_us
+			&& run->next_burst_us < run->end_us) {
+		cdc_model_advance(run->next_burst_us);
+		for (uint32_t i = 0; i < run->n_mix; i++)
+			usbtx_send(&run->mix[i]);
+		run->next_burst_us += (uint64_t) (1e6 / run->rate_hz);
+	}
+
+	cdc_model_advance(t_us);
+	if (cdc_model_now_us() >= run->end_us)
+		longjmp(run->done, 1);
+
+	while (run->saturate
+			&& uxQueueMessagesWaiting(xUsbTxQueue) < USB_TX_QUEUE_LENGTH) {
+		usbtx_item_t *it = &run->mix[run->next_item];
+		run->next_item = (run->next_item + 1) % run->n_mix;
+		usbtx_send(it);
+		if (it->dropped_size == it->offered)
+			break;  // nothing of this mix fits a frame
+	}
+}
+
+// host_block_hook: usbTask blocks in vTaskDelay() or on its queue set
+static void usbtx_block(TickType_t ticks) {
+	uint64_t now = cdc_model_now_us();
+
+	if (ticks == portMAX_DELAY) {
+		// idle until the next burst (or the end of the run)
+		usbtx_advance(run->saturate ? now : run->next_burst_us);
+	} else {
+		// vTaskDelay(n) wakes on the n-th tick interrupt from now
+		usbtx_advance((now / USBTX_TICK_US + ticks) * USBTX_TICK_US);
+	}
+}
+
+static void usbtx_run(usbtx_t *u) {
+	cdc_model_stats_t cdc;
+
+	run = u;
+	for (uint32_t i = 0; i < u->n_mix; i++) {
+		usbtx_item_t *it = &u->mix[i];
+		it->offered = it->queued = it->dropped_full = it->dropped_size = 0;
+	}
+	u->end_us = (uint64_t) (u->duration_s * 1e6);
+	u->next_burst_us = 0;
+	u->next_item = 0;
+
+	cdc_model_init(&u->cdc);
+	usb_init();
+	host_block_hook = usbtx_block;
+
+	if (setjmp(u->done) == 0) {
+		usbtx_advance(0);
+		usbTask(NULL);
+	}
+	host_block_hook = NULL;
+	cdc_model_get_stats(&cdc);
+
+	uint64_t queued = 0;
+	for (uint32_t i = 0; i < u->n_mix; i++)
+		queued += u->mix[i].queued;
+	// frames still queued at the end did not make it out
+	uint64_t sent = queued - uxQueueMessagesWaiting(xUsbTxQueue);
+	uint32_t tx_drops, rx_drops;
+	usb_get_diagnostics(&tx_drops, &rx_drops);
+
+	double s = u->duration_s;
+	double link_Bps = (double) u->cdc.packets_per_frame * u->cdc.packet_size
+			* 1e6 / u->cdc.frame_us;
+
+	printf("%-12s %10s %10s %10s %10s %10s\n", "message", "offered",
+			"queued", "full", "too large", "len");
+	for (uint32_t i = 0; i < u->n_mix; i++) {
+		const usbtx_item_t *it = &u->mix[i];
+		printf("%-12s %10llu %10llu %10llu %10llu", it->label,
+				(unsigned long long) it->offered,
+				(unsigned long long) it->queued,
+				(unsigned long long) it->dropped_full,
+				(unsigned long long) it->dropped_size);
+		if (it->type == MSG_RAW)
+			printf(" %10u", it->raw_len);
+		printf("\n");
+	}
+	printf("sent %.1f msg/s, %.0f B/s (%.1f%% of %.0f B/s link), "
+			"%.1f CDC transfers/s, %llu busy, %u usbTask drops\n",
+			sent / s, cdc.bytes / s, 100.0 * cdc.bytes / s / link_Bps,
+			link_Bps, cdc.transfers / s, (unsigned long long) cdc.busy,
+			tx_drops);
+}
+
+// "status,kf_debug,profile,raw:N" (an item may repeat)
+static int parse_mix(const char *spec, usbtx_t *u) {
+	char buf[256];
+	snprintf(buf, sizeof(buf), "%s", spec);
+	u->n_mix = 0;
+
+	for (char *tok = strtok(buf, ","); tok; tok = strtok(NULL, ",")) {
+		if (u->n_mix >= USBTX_MAX_MIX)
+			return -1;
+		usbtx_item_t *it = &u->mix[u->n_mix];
+		memset(it, 0, sizeof(*it));
+
+		if (strncmp(tok, "raw:", 4) == 0) {
+			int len = atoi(tok + 4);
+			if (len < 1 || len > USB_MSG_MAX_SIZE)
+				return -1;
+			it->type = MSG_RAW;
+			it->raw_len = (uint16_t) len;
+			snprintf(it->label, sizeof(it->label), "raw:%d", len);
+		} else {
+			int k;
+			for (k = 0; k < MSG_RAW; k++)
+				if (strcmp(tok, msg_names[k]) == 0)
+					break;
+			if (k == MSG_RAW)
+				return -1;
+			it->type = (usbtx_msg_t) k;
+			snprintf(it->label, sizeof(it->label), "%s", msg_names[k]);
+		}
+		u->n_mix++;
+	}
+	return u->n_mix > 0 ? 0 : -1;
+}
+
+enum {
+	OPT_MIX = 256,
+	OPT_RATE,
+	OPT_SATURATE,
+	OPT_SECONDS,
+	OPT_PPF,
+	OPT_SWEEP,
+};
+
+static const struct option long_options[] = {
+	{ "mix", required_argument, NULL, OPT_MIX },
+	{ "rate", required_argument, NULL, OPT_RATE },
+	{ "saturate", no_argument, NULL, OPT_SATURATE },
+	{ "seconds", required_argument, NULL, OPT_SECONDS },
+	{ "packets-per-frame", required_argument, NULL, OPT_PPF },
+	{ "sweep", no_argument, NULL, OPT_SWEEP },
+	{ "help", no_argument, NULL, 'h' },
+	{ NULL, 0, NULL, 0 },
+};
+
+static void usage(const char *prog) {
+	fprintf(stderr,
+			"usage: %s [options]\n"
+			"  --mix LIST               messages per burst: status, kf_debug,\n"
+			"                           profile, raw:N (default status,kf_debug)\n"
+			"  --rate HZ                bursts per second (default 1, the PPS)\n"
+			"  --saturate               keep the TX queue full instead\n"
+			"  --seconds S              virtual run time (default 60)\n"
+			"  --packets-per-frame N    bulk packets the host schedules per\n"
+			"                           1 ms frame (default 19)\n"
+			"  --sweep                  saturated raw frames of 16..256 bytes\n",
+			prog);
+}
+
+int main(int argc, char **argv) {
+	static usbtx_t u;
+	int sweep = 0;
+	int opt;
+
+	u.rate_hz = 1.0;
+	u.duration_s = 60.0;
+	cdc_model_params_default(&u.cdc);
+	parse_mix("status,kf_debug", &u);
+
+	// a realistic snapshot; only its encoded size matters here
+	for (int i = 0; i < 9; i++)
+		kf_snapshot.P[i] = kf_snapshot.Q[i] = 1e-3f * (i + 1);
+	for (int i = 0; i < PROFILE_HIST_BUCKETS; i++)
+		profile_stats.hist[i] = (i >= 8 && i < 16) ? 100 : 0;
+
+	while ((opt = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+		switch (opt) {
+		case OPT_MIX:
+			if (parse_mix(optarg, &u) != 0) {
+				fprintf(stderr, "bad mix %s\n", optarg);
+				return 2;
+			}
+			break;
+		case OPT_RATE: u.rate_hz = strtod(optarg, NULL); break;
+		case OPT_SATURATE: u.saturate = 1; break;
+		case OPT_SECONDS: u.duration_s = strtod(optarg, NULL); break;
+		case OPT_PPF: u.cdc.packets_per_frame = (uint32_t) atoi(optarg); break;
+		case OPT_SWEEP: sweep = 1; break;
+		default:
+			usage(argv[0]);
+			return opt == 'h' ? 0 : 2;
+		}
+	}
+
+	if (u.rate_hz <= 0.0 || u.duration_s <= 0.0
+			|| u.cdc.packets_per_frame < 1) {
+		usage(argv[0]);
+		return 2;
+	}
+
+	if (sweep) {
+		static const int sizes[] = { 16, 32, 64, 96, 128, 192, 250, 256 };
+		u.saturate = 1;
+		for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+			char spec[16];
+			snprintf(spec, sizeof(spec), "raw:%d", sizes[i]);
+			parse_mix(spec, &u);
+			usbtx_run(&u);
+			printf("\n");
+		}
+		return 0;
+	}
+
+	printf("%s, %.0f s, %u packets/frame\n",
+			u.saturate ? "saturated" : "bursts", u.duration_s,
+			u.cdc.packets_per_frame);
+	usbtx_run(&u);
+	return 0;
+}
@@ -0,0 +1,265 @@
+/*
+ * flatbuf_host_encoder.c
+ *
+ *  Fallback telemetry encoder for host builds without the flatcc runtime
+ *  (with it, CMake links flatbuf_message_builder.c instead). Builds
+ *  the same gpsdo.Message FlatBuffers as flatbuf_message_builder.c (Status,
+ *  kf_debug, Profile and kf_smooth payloads) and queues them on xUsbTxQueue in the
+ *  flatbuf_message_t framing, so anything downstream of usbTask sees what
+ *  the target sends.
+ *
+ *  The buffer is laid out front to back (root, Message, payload, children)
+ *  instead of flatcc's back to front; every reference is still a forward
+ *  uoffset, so the result is a valid FlatBuffer for any reader. Scalars
+ *  are stored in host byte order, which is little endian on every
+ *  supported host.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "flatbuf_message_builder.h"
+#include "usb.h"
+
+#include <string.h>
+
+#define FBW_BUF_SIZE 1024
+
+typedef struct {
+	uint8_t buf[FBW_BUF_SIZE];
+	uint32_t len;
+	int overflow;
+} fbw_t;
+
+// field ids of the gpsdo.fbs tables
+enum { MSG_TIMESTAMP, MSG_PAYLOAD_TYPE, MSG_PAYLOAD, MSG_FIELDS };
+enum {
+	PAYLOAD_STATUS = 1, PAYLOAD_KF_DEBUG = 2, PAYLOAD_PROFILE = 3,
+	PAYLOAD_KF_SMOOTH = 4
+};
+
+static uint32_t fbw_alloc(fbw_t *w, uint32_t size, uint32_t align) {
+	uint32_t pos = (w->len + align - 1) & ~(align - 1);
+	if (pos + size > sizeof(w->buf)) {
+		w->overflow = 1;
+		return 0;
+	}
+	memset(w->buf + w->len, 0, pos + size - w->len);
+	w->len = pos + size;
+	return pos;
+}
+
+static void fbw_put(fbw_t *w, uint32_t pos, const void *v, uint32_t size) {
+	if (!w->overflow)
+		memcpy(w->buf + pos, v, size);
+}
+
+static void fbw_put_u16(fbw_t *w, uint32_t pos, uint16_t v) {
+	fbw_put(w, pos, &v, sizeof(v));
+}
+
+static void fbw_put_u32(fbw_t *w, uint32_t pos, uint32_t v) {
+	fbw_put(w, pos, &v, sizeof(v));
+}
+
+static void fbw_put_f32(fbw_t *w, uint32_t pos, float v) {
+	fbw_put(w, pos, &v, sizeof(v));
+}
+
+// uoffset stored at pos pointing forward to target
+static void fbw_ref(fbw_t *w, uint32_t pos, uint32_t target) {
+	fbw_put_u32(w, pos, target - pos);
+}
+
+/*
+ * Lays out a vtable followed by its table. size[i] is the byte size of
+ * field i (0 = absent); pos[i] receives its absolute buffer position.
+ * Fields are packed largest first so each one is naturally aligned.
+ */
+static uint32_t fbw_table(fbw_t *w, const uint8_t *size, int n, uint32_t *pos) {
+	uint32_t align = 4;
+	for (int i = 0; i < n; i++)
+		if (size[i] > align)
+			align = size[i];
+
+	uint32_t vt = fbw_alloc(w, 4 + 2 * n, 2);
+	uint32_t tbl = fbw_alloc(w, 4, align);
+
+	for (uint32_t sz = 8; sz >= 1; sz /= 2)
+		for (int i = 0; i < n; i++)
+			if (size[i] == sz)
+				pos[i] = fbw_alloc(w, sz, sz);
+
+	fbw_put_u16(w, vt, (uint16_t) (4 + 2 * n));
+	fbw_put_u16(w, vt + 2, (uint16_t) (w->len - tbl));
+	for (int i = 0; i < n; i++)
+		fbw_put_u16(w, vt + 4 + 2 * i, size[i] ? (uint16_t) (pos[i] - tbl) : 0);
+
+	// table -> vtable is a signed offset: vtable = table - soffset
+	int32_t soff = (int32_t) (tbl - vt);
+	fbw_put(w, tbl, &soff, sizeof(soff));
+	return tbl;
+}
+
+static uint32_t fbw_vector(fbw_t *w, const void *data, uint32_t count,
+		uint32_t elem_size) {
+	uint32_t pos = fbw_alloc(w, 4 + count * elem_size, 4);
+	fbw_put_u32(w, pos, count);
+	fbw_put(w, pos + 4, data, count * elem_size);
+	return pos;
+}
+
+// Vec3 / Mat3x3 / Mat1x3 / Mat3x1: one [float] field
+static uint32_t fbw_float_table(fbw_t *w, const float *v, uint32_t count) {
+	static const uint8_t size[1] = { 4 };
+	uint32_t pos[1];
+	uint32_t tbl = fbw_table(w, size, 1, pos);
+	fbw_ref(w, pos[0], fbw_vector(w, v, count, sizeof(float)));
+	return tbl;
+}
+
+// Root uoffset and the Message envelope; returns the payload field position
+static uint32_t fbw_message(fbw_t *w, double timestamp_s, uint8_t type) {
+	static const uint8_t size[MSG_FIELDS] = { 8, 1, 4 };
+	uint32_t pos[MSG_FIELDS];
+
+	w->len = 0;
+	w->overflow = 0;
+	uint32_t root = fbw_alloc(w, 4, 8);
+	fbw_ref(w, root, fbw_table(w, size, MSG_FIELDS, pos));
+	fbw_put(w, pos[MSG_TIMESTAMP], &timestamp_s, sizeof(timestamp_s));
+	fbw_put(w, pos[MSG_PAYLOAD_TYPE], &type, 1);
+	return pos[MSG_PAYLOAD];
+}
+
+static void flatbuf_send(uint16_t msg_id, const fbw_t *w) {
+	if (w->overflow || w->len > sizeof(((flatbuf_message_t*) 0)->data))
+		return; // too large, dropped as on the target
+
+	flatbuf_message_t msg;
+	msg.magic = FLATBUF_MAGIC;
+	msg.msg_id = msg_id;
+	msg.len = (uint16_t) w->len;
+	memcpy(msg.data, w->buf, w->len);
+
+	xQueueSend(xUsbTxQueue, &msg, 0);
+}
+
+void flatbuf_send_status(float phase_cnt, float freq_error, float freq_drift,
+		float vctrl, float vmeas, float temp, uint32_t raw_counter_value,
+		const float *mode_prob, const pps_stats_t *pps) {
+	static fbw_t w;
+	// mode_prob (Vec3) only with the IMM filter, the PPS counters when given
+	const uint8_t p = pps ? 4 : 0;
+	const uint8_t size[12] = { 4, 4, 4, 4, 4, 4, 4, mode_prob ? 4 : 0,
+			p, p, p, p };
+	uint32_t pos[12];
+
+	uint32_t payload = fbw_message(&w, 0.0, PAYLOAD_STATUS);
+	fbw_ref(&w, payload, fbw_table(&w, size, 12, pos));
+	fbw_put_f32(&w, pos[0], phase_cnt);
+	fbw_put_f32(&w, pos[1], freq_error);
+	fbw_put_f32(&w, pos[2], freq_drift);
+	fbw_put_f32(&w, pos[3], vctrl);
+	fbw_put_f32(&w, pos[4], vmeas);
+	fbw_put_f32(&w, pos[5], temp);
+	fbw_put_u32(&w, pos[6], raw_counter_value);
+	if (mode_prob)
+		fbw_ref(&w, pos[7], fbw_float_table(&w, mode_prob, 3));
+	if (pps) {
+		fbw_put_u32(&w, pos[8], pps->seq);
+		fbw_put_u32(&w, pos[9], pps->overruns);
+		fbw_put_u32(&w, pos[10], pps->backlog_max);
+		fbw_put_u32(&w, pos[11], pps->sw_reads);
+	}
+
+	flatbuf_send(FLATBUF_MSG_STATUS, &w);
+}
+
+void flatbuf_send_kf_debug(const KF_DebugSnapshot *kf) {
+	static fbw_t w;
+	static const uint8_t dbg_size[11] = { 8, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4 };
+	static const uint8_t state_size[3] = { 4, 4, 4 };
+	static const uint8_t corr_size[7] = { 4, 4, 4, 4, 4, 4, 1 };
+	uint32_t dbg[11], state[3], corr[7];
+
+	uint32_t payload = fbw_message(&w, kf->timestamp_s, PAYLOAD_KF_DEBUG);
+	fbw_ref(&w, payload, fbw_table(&w, dbg_size, 11, dbg));
+	fbw_put(&w, dbg[0], &kf->timestamp_s, sizeof(kf->timestamp_s));
+	fbw_put_f32(&w, dbg[6], kf->R);
+	fbw_put_u32(&w, dbg[7], kf->outlier_count);
+	fbw_put_u32(&w, dbg[8], kf->iteration);
+	fbw_put_u32(&w, dbg[9], kf->cov_health_count);
+	fbw_put_u32(&w, dbg[10], kf->reacq_count);
+
+	// state: x, P, drift
+	fbw_ref(&w, dbg[1], fbw_table(&w, state_size, 3, state));
+	fbw_put_f32(&w, state[2], kf->x[2]);
+	fbw_ref(&w, state[0], fbw_float_table(&w, kf->x, 3));
+	fbw_ref(&w, state[1], fbw_float_table(&w, kf->P, 9));
+
+	// correction block
+	uint8_t rejected = kf->rejected;
+	fbw_ref(&w, dbg[2], fbw_table(&w, corr_size, 7, corr));
+	fbw_put_f32(&w, corr[0], kf->z);
+	fbw_put_f32(&w, corr[1], kf->h_x);
+	fbw_put_f32(&w, corr[2], kf->y);
+	fbw_put_f32(&w, corr[3], kf->S);
+	fbw_put_f32(&w, corr[4], kf->mahal_d2);
+	fbw_put_f32(&w, corr[5], kf->nis);
+	fbw_put(&w, corr[6], &rejected, 1);
+
+	fbw_ref(&w, dbg[3], fbw_float_table(&w, kf->K, 3));
+	fbw_ref(&w, dbg[4], fbw_float_table(&w, kf->H, 3));
+	fbw_ref(&w, dbg[5], fbw_float_table(&w, kf->Q, 9));
+
+	flatbuf_send(FLATBUF_MSG_KF_DEBUG, &w);
+}
+
+void flatbuf_send_profile(uint8_t section, const profile_stats_t *stats,
+		uint32_t cpu_hz) {
+	static fbw_t w;
+	static const uint8_t size[9] = { 1, 4, 4, 4, 4, 4, 4, 1, 4 };
+	uint32_t pos[9];
+
+	// trim empty histogram buckets at both ends
+	int first = 0;
+	int last = PROFILE_HIST_BUCKETS - 1;
+	while (first < last && stats->hist[first] == 0)
+		first++;
+	while (last > first && stats->hist[last] == 0)
+		last--;
+
+	uint8_t first_bucket = (uint8_t) first;
+	uint32_t payload = fbw_message(&w, 0.0, PAYLOAD_PROFILE);
+	fbw_ref(&w, payload, fbw_table(&w, size, 9, pos));
+	fbw_put(&w, pos[0], &section, 1);
+	fbw_put_u32(&w, pos[1], cpu_hz);
+	fbw_put_u32(&w, pos[2], stats->count);
+	fbw_put_u32(&w, pos[3], stats->count ? stats->min : 0);
+	fbw_put_u32(&w, pos[4], stats->max);
+	fbw_put_f32(&w, pos[5],
+			stats->count ? (float) stats->sum / (float) stats->count : 0.0f);
+	fbw_put_u32(&w, pos[6], stats->last);
+	fbw_put(&w, pos[7], &first_bucket, 1);
+	fbw_ref(&w, pos[8], fbw_vector(&w, &stats->hist[first],
+			(uint32_t) (last - first + 1), sizeof(uint32_t)));
+
+	flatbuf_send(FLATBUF_MSG_PROFILE, &w);
+}
+
+void flatbuf_send_kf_smooth(const KF_SmoothSnapshot *sm) {
+	static fbw_t w;
+	static const uint8_t size[6] = { 8, 4, 2, 4, 4, 4 };
+	uint32_t pos[6];
+
+	uint32_t payload = fbw_message(&w, sm->timestamp_s, PAYLOAD_KF_SMOOTH);
+	fbw_ref(&w, payload, fbw_table(&w, size, 6, pos));
+	fbw_put(&w, pos[0], &sm->timestamp_s, sizeof(sm->timestamp_s));
+	fbw_put_u32(&w, pos[1], sm->iteration);
+	fbw_put_u16(&w, pos[2], sm->lag);
+	fbw_ref(&w, pos[3], fbw_float_table(&w, sm->x, 3));
+	fbw_ref(&w, pos[4], fbw_float_table(&w, sm->sigma, 3));
+	fbw_ref(&w, pos[5], fbw_float_table(&w, sm->x_filt, 3));
+
+	flatbuf_send(FLATBUF_MSG_KF_SMOOTH, &w);
+}
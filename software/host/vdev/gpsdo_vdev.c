@@ -0,0 +1,293 @@
+/*
+ * gpsdo_vdev.c
+ *
+ *  Virtual GPSDO: runs the firmware controller on the host, driven by the
+ *  closed-loop simulator or a replayed log, and writes the telemetry
+ *  usbTask would send (flatbuf_message_t frames) to a pseudo-terminal.
+ *  tools/com/reader.py can open the PTY like the CDC device of a board.
+ *
+ *  Every PPS the queued frames are written out and the run is paced to
+ *  --speed times real time (0 = as fast as the reader takes them).
+ *
+ *  usage: gpsdo_vdev [--link PATH] [--speed N] [--replay log.csv | sim options]
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "gpsdo_sim.h"
+#include "csv_log.h"
+#include "controller.h"
+#include "flatbuf_defs.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define VDEV_WRITE_TIMEOUT_MS 1000   // as usbTask's ~1 s retry budget
+
+typedef struct {
+	int master;
+	int slave;                  // held open so the PTY survives reader restarts
+	double speed;
+	struct timespec t0;
+	int quiet;
+
+	uint64_t frames;
+	uint64_t bytes;
+	uint64_t dropped;           // frames not (fully) taken by the reader
+	uint64_t seconds;
+} vdev_t;
+
+// normally owned by usb.c
+QueueHandle_t xUsbTxQueue = NULL;
+
+static volatile sig_atomic_t vdev_stop = 0;
+
+static void on_signal(int sig) {
+	(void) sig;
+	vdev_stop = 1;
+}
+
+static int vdev_open_pty(vdev_t *v, const char *link) {
+	v->master = posix_openpt(O_RDWR | O_NOCTTY);
+	if (v->master < 0 || grantpt(v->master) != 0
+			|| unlockpt(v->master) != 0) {
+		perror("posix_openpt");
+		return -1;
+	}
+
+	const char *name = ptsname(v->master);
+	v->slave = open(name, O_RDWR | O_NOCTTY);
+	if (v->slave < 0) {
+		perror(name);
+		return -1;
+	}
+
+	// raw binary line, no echo or CR/LF translation of the frames
+	struct termios tio;
+	tcgetattr(v->slave, &tio);
+	cfmakeraw(&tio);
+	tcsetattr(v->slave, TCSANOW, &tio);
+
+	fcntl(v->master, F_SETFL, fcntl(v->master, F_GETFL) | O_NONBLOCK);
+
+	if (link) {
+		unlink(link);
+		if (symlink(name, link) != 0) {
+			perror(link);
+			return -1;
+		}
+	}
+
+	printf("virtual GPSDO on %s%s%s\n", name, link ? " -> " : "",
+			link ? link : "");
+	fflush(stdout);
+	return 0;
+}
+
+// Writes a whole frame; gives up like usbTask when the reader stalls.
+static int vdev_write(vdev_t *v, const uint8_t *buf, size_t len) {
+	size_t off = 0;
+
+	while (off < len) {
+		ssize_t w = write(v->master, buf + off, len - off);
+		if (w > 0) {
+			off += (size_t) w;
+			continue;
+		}
+		if (w < 0 && errno != EAGAIN && errno != EINTR)
+			return -1;
+
+		// nothing was taken yet: drop the frame instead of blocking
+		if (off == 0)
+			return -1;
+
+		struct pollfd pfd = { .fd = v->master, .events = POLLOUT };
+		if (poll(&pfd, 1, VDEV_WRITE_TIMEOUT_MS) <= 0)
+			return -1;
+	}
+	return 0;
+}
+
+static void vdev_flush(vdev_t *v) {
+	flatbuf_message_t msg;
+
+	while (xQueueReceive(xUsbTxQueue, &msg, 0) == pdTRUE) {
+		// header + payload, exactly the bytes usbTask hands to CDC
+		size_t len = sizeof(msg.magic) + sizeof(msg.msg_id) + sizeof(msg.len)
+				+ msg.len;
+		if (vdev_write(v, (const uint8_t*) &msg, len) == 0) {
+			v->frames++;
+			v->bytes += len;
+		} else
+			v->dropped++;
+	}
+}
+
+// Sleeps until second t (counted from the start) is due at --speed.
+static void vdev_pace(vdev_t *v, double t) {
+	if (v->speed <= 0.0)
+		return;
+
+	double due = (t + 1.0) / v->speed;
+	struct timespec ts = v->t0;
+	ts.tv_sec += (time_t) due;
+	ts.tv_nsec += (long) ((due - (double) (time_t) due) * 1e9);
+	if (ts.tv_nsec >= 1000000000L) {
+		ts.tv_sec++;
+		ts.tv_nsec -= 1000000000L;
+	}
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR
+			&& !vdev_stop)
+		;
+}
+
+static int vdev_second(double t, void *ctx) {
+	vdev_t *v = ctx;
+
+	vdev_flush(v);
+	v->seconds++;
+
+	if (!v->quiet && v->seconds % 60 == 0) {
+		fprintf(stderr, "\r%llu s, %llu frames, %llu bytes, %llu dropped",
+				(unsigned long long) v->seconds,
+				(unsigned long long) v->frames, (unsigned long long) v->bytes,
+				(unsigned long long) v->dropped);
+	}
+
+	vdev_pace(v, t);
+	return vdev_stop;
+}
+
+static int vdev_replay(vdev_t *v, const char *path, int loop) {
+	csv_log_t log;
+	if (csv_log_load(path, &log) != 0)
+		return -1;
+
+	double t = 0.0;
+	do {
+		controller_init();
+		for (size_t i = 0; i < log.n && !vdev_stop; i++) {
+			controller_step(log.raw_count[i]);
+			vdev_second(t, v);
+			t += 1.0;
+		}
+	} while (loop && !vdev_stop);
+
+	csv_log_free(&log);
+	return 0;
+}
+
+enum {
+	OPT_LINK = 256,
+	OPT_SPEED,
+	OPT_REPLAY,
+	OPT_LOOP,
+	OPT_DAYS,
+	OPT_SECONDS,
+	OPT_SEED,
+	OPT_OPEN_LOOP,
+};
+
+static const struct option long_options[] = {
+	{ "link", required_argument, NULL, OPT_LINK },
+	{ "speed", required_argument, NULL, OPT_SPEED },
+	{ "replay", required_argument, NULL, OPT_REPLAY },
+	{ "loop", no_argument, NULL, OPT_LOOP },
+	{ "days", required_argument, NULL, OPT_DAYS },
+	{ "seconds", required_argument, NULL, OPT_SECONDS },
+	{ "seed", required_argument, NULL, OPT_SEED },
+	{ "open-loop", no_argument, NULL, OPT_OPEN_LOOP },
+	{ "quiet", no_argument, NULL, 'q' },
+	{ "help", no_argument, NULL, 'h' },
+	{ NULL, 0, NULL, 0 },
+};
+
+static void usage(const char *prog) {
+	fprintf(stderr,
+			"usage: %s [options]\n"
+			"  --link PATH              symlink to the PTY (e.g. /tmp/gpsdo)\n"
+			"  --speed N                N x real time (default 1, 0 = unpaced)\n"
+			"  -q, --quiet              no progress on stderr\n"
+			" source (default: closed-loop simulator):\n"
+			"  --replay FILE [--loop]   replay a reader.py CSV log\n"
+			"  --days D / --seconds S   simulated time (default 30 days)\n"
+			"  --seed N --open-loop     simulator seed, do not drive the DAC\n",
+			prog);
+}
+
+int main(int argc, char **argv) {
+	vdev_t v = { .master = -1, .slave = -1, .speed = 1.0 };
+	const char *link = NULL;
+	const char *replay = NULL;
+	int loop = 0;
+	sim_config_t cfg;
+	int opt;
+
+	sim_config_defaults(&cfg);
+	cfg.duration_s = 30.0 * 86400.0;
+
+	while ((opt = getopt_long(argc, argv, "qh", long_options, NULL)) != -1) {
+		switch (opt) {
+		case OPT_LINK: link = optarg; break;
+		case OPT_SPEED: v.speed = strtod(optarg, NULL); break;
+		case OPT_REPLAY: replay = optarg; break;
+		case OPT_LOOP: loop = 1; break;
+		case OPT_DAYS: cfg.duration_s = strtod(optarg, NULL) * 86400.0; break;
+		case OPT_SECONDS: cfg.duration_s = strtod(optarg, NULL); break;
+		case OPT_SEED: cfg.seed = strtoull(optarg, NULL, 0); break;
+		case OPT_OPEN_LOOP: cfg.open_loop = 1; break;
+		case 'q': v.quiet = 1; break;
+		default:
+			usage(argv[0]);
+			return opt == 'h' ? 0 : 2;
+		}
+	}
+
+	if (optind < argc || v.speed < 0.0 || cfg.duration_s < 1.0) {
+		usage(argv[0]);
+		return 2;
+	}
+
+	signal(SIGINT, on_signal);
+	signal(SIGTERM, on_signal);
+	signal(SIGPIPE, SIG_IGN);
+
+	xUsbTxQueue = xQueueCreate(USB_TX_QUEUE_LENGTH, sizeof(flatbuf_message_t));
+	if (!xUsbTxQueue || vdev_open_pty(&v, link) != 0)
+		return 1;
+
+	clock_gettime(CLOCK_MONOTONIC, &v.t0);
+
+	int rc = 0;
+	if (replay) {
+		rc = vdev_replay(&v, replay, loop) != 0;
+	} else {
+		sim_result_t res;
+		cfg.on_second = vdev_second;
+		cfg.ctx = &v;
+		rc = sim_run(&cfg, &res) != 0;
+	}
+
+	if (!v.quiet)
+		fprintf(stderr, "\n");
+	printf("%llu s, %llu frames, %llu bytes, %llu dropped\n",
+			(unsigned long long) v.seconds, (unsigned long long) v.frames,
+			(unsigned long long) v.bytes, (unsigned long long) v.dropped);
+
+	if (link)
+		unlink(link);
+	close(v.slave);
+	close(v.master);
+	return rc;
+}
@@ -0,0 +1,82 @@
+#!/bin/sh
+# Regenerates the FlatBuffers code from gpsdo.fbs: the flatcc C headers in
+# include/ (as generate.bat) and the Python bindings in tools/com/schemas
+# (as tools/com/generate.bat). Both generators are pinned to the versions
+# the checked-in code was produced with.
+#
+#   generate.sh           regenerate in place
+#   generate.sh --check   regenerate into a scratch dir and diff against the
+#                         tree, exit 1 when the checked-in code is stale
+set -e
+
+FLATCC_VERSION=0.6.2
+FLATC_VERSION=25.9.23   # tools/flatbuf/flatc.exe
+
+dir=$(cd "$(dirname "$0")" && pwd)
+flatcc="${FLATCC:-$dir/../gpsdo/libs/flatcc/bin/flatcc}"
+flatc="${FLATC:-flatc}"
+c_out="$dir/include"
+py_out="$dir/../../tools/com/schemas"
+
+check=0
+if [ "$1" = "--check" ]; then
+	check=1
+elif [ -n "$1" ]; then
+	echo "usage: $0 [--check]" >&2
+	exit 2
+fi
+
+if [ ! -x "$flatcc" ]; then
+	echo "Error: flatcc not found at $flatcc (build the libs/flatcc submodule or set FLATCC)" >&2
+	exit 1
+fi
+if ! "$flatcc" --version 2>&1 | grep -q "$FLATCC_VERSION"; then
+	echo "Error: $flatcc is not flatcc $FLATCC_VERSION" >&2
+	exit 1
+fi
+if ! command -v "$flatc" >/dev/null 2>&1; then
+	echo "Error: flatc not found (install flatc $FLATC_VERSION or set FLATC)" >&2
+	exit 1
+fi
+if ! "$flatc" --version 2>&1 | grep -q "$FLATC_VERSION"; then
+	echo "Error: $flatc is not flatc $FLATC_VERSION" >&2
+	exit 1
+fi
+
+if [ $check -eq 1 ]; then
+	tmp=$(mktemp -d)
+	trap 'rm -rf "$tmp"' EXIT
+	mkdir -p "$tmp/include" "$tmp/python"
+	"$flatcc" -a -o "$tmp/include" "$dir/gpsdo.fbs"
+	"$flatc" --python -o "$tmp/python" "$dir/gpsdo.fbs"
+
+	stale=0
+	for f in "$tmp/include/"*; do
+		cmp -s "$f" "$c_out/$(basename "$f")" || {
+			echo "stale: software/schemas/include/$(basename "$f")" >&2
+			stale=1
+		}
+	done
+	for f in "$tmp/python/gpsdo/"*; do
+		cmp -s "$f" "$py_out/gpsdo/$(basename "$f")" || {
+			echo "stale: tools/com/schemas/gpsdo/$(basename "$f")" >&2
+			stale=1
+		}
+	done
+	if [ $stale -eq 1 ]; then
+		echo "Generated code is out of date, run $0" >&2
+		exit 1
+	fi
+	echo "Generated code is up to date."
+	exit 0
+fi
+
+echo "Generating C headers..."
+mkdir -p "$c_out"
+rm -f "$c_out/"*
+"$flatcc" -a -o "$c_out" "$dir/gpsdo.fbs"
+
+echo "Generating Python bindings..."
+"$flatc" --python -o "$py_out" "$dir/gpsdo.fbs"
+
+echo "Schema generation completed successfully."
@@ -24,7 +24,7 @@ static gpsdo_Payload_union_ref_t gpsdo_Payload_clone(flatbuffers_builder_t *B, g
 static const flatbuffers_voffset_t __gpsdo_Status_required[] = { 0 };
 typedef flatbuffers_ref_t gpsdo_Status_ref_t;
 static gpsdo_Status_ref_t gpsdo_Status_clone(flatbuffers_builder_t *B, gpsdo_Status_table_t t);
-__flatbuffers_build_table(flatbuffers_, gpsdo_Status, 7)
+__flatbuffers_build_table(flatbuffers_, gpsdo_Status, 12)
 
 static const flatbuffers_voffset_t __gpsdo_Mat3x3_required[] = { 0 };
 typedef flatbuffers_ref_t gpsdo_Mat3x3_ref_t;
@@ -59,7 +59,17 @@ __flatbuffers_build_table(flatbuffers_, gpsdo_kf_state_debug, 3)
 static const flatbuffers_voffset_t __gpsdo_kf_debug_required[] = { 0 };
 typedef flatbuffers_ref_t gpsdo_kf_debug_ref_t;
 static gpsdo_kf_debug_ref_t gpsdo_kf_debug_clone(flatbuffers_builder_t *B, gpsdo_kf_debug_table_t t);
-__flatbuffers_build_table(flatbuffers_, gpsdo_kf_debug, 9)
+__flatbuffers_build_table(flatbuffers_, gpsdo_kf_debug, 11)
+
+static const flatbuffers_voffset_t __gpsdo_Profile_required[] = { 0 };
+typedef flatbuffers_ref_t gpsdo_Profile_ref_t;
+static gpsdo_Profile_ref_t gpsdo_Profile_clone(flatbuffers_builder_t *B, gpsdo_Profile_table_t t);
+__flatbuffers_build_table(flatbuffers_, gpsdo_Profile, 9)
+
+static const flatbuffers_voffset_t __gpsdo_kf_smooth_required[] = { 0 };
+typedef flatbuffers_ref_t gpsdo_kf_smooth_ref_t;
+static gpsdo_kf_smooth_ref_t gpsdo_kf_smooth_clone(flatbuffers_builder_t *B, gpsdo_kf_smooth_table_t t);
+__flatbuffers_build_table(flatbuffers_, gpsdo_kf_smooth, 6)
 
 static const flatbuffers_voffset_t __gpsdo_Message_required[] = { 0 };
 typedef flatbuffers_ref_t gpsdo_Message_ref_t;
@@ -68,10 +78,12 @@ __flatbuffers_build_table(flatbuffers_, gpsdo_Message, 3)
 
 #define __gpsdo_Status_formal_args ,\
   float v0, float v1, float v2, float v3,\
-  float v4, float v5, uint32_t v6
+  float v4, float v5, uint32_t v6, gpsdo_Vec3_ref_t v7,\
+  uint32_t v8, uint32_t v9, uint32_t v10, uint32_t v11
 #define __gpsdo_Status_call_args ,\
   v0, v1, v2, v3,\
-  v4, v5, v6
+  v4, v5, v6, v7,\
+  v8, v9, v10, v11
 static inline gpsdo_Status_ref_t gpsdo_Status_create(flatbuffers_builder_t *B __gpsdo_Status_formal_args);
 __flatbuffers_build_table_prolog(flatbuffers_, gpsdo_Status, gpsdo_Status_file_identifier, gpsdo_Status_type_identifier)
 
@@ -111,13 +123,33 @@ __flatbuffers_build_table_prolog(flatbuffers_, gpsdo_kf_state_debug, gpsdo_kf_st
 
 #define __gpsdo_kf_debug_formal_args ,\
   double v0, gpsdo_kf_state_debug_ref_t v1, gpsdo_kf_correction_debug_ref_t v2, gpsdo_Mat3x1_ref_t v3,\
-  gpsdo_Mat1x3_ref_t v4, gpsdo_Mat3x3_ref_t v5, float v6, uint32_t v7, uint32_t v8
+  gpsdo_Mat1x3_ref_t v4, gpsdo_Mat3x3_ref_t v5, float v6, uint32_t v7,\
+  uint32_t v8, uint32_t v9, uint32_t v10
 #define __gpsdo_kf_debug_call_args ,\
   v0, v1, v2, v3,\
-  v4, v5, v6, v7, v8
+  v4, v5, v6, v7,\
+  v8, v9, v10
 static inline gpsdo_kf_debug_ref_t gpsdo_kf_debug_create(flatbuffers_builder_t *B __gpsdo_kf_debug_formal_args);
 __flatbuffers_build_table_prolog(flatbuffers_, gpsdo_kf_debug, gpsdo_kf_debug_file_identifier, gpsdo_kf_debug_type_identifier)
 
+#define __gpsdo_Profile_formal_args ,\
+  uint8_t v0, uint32_t v1, uint32_t v2, uint32_t v3,\
+  uint32_t v4, float v5, uint32_t v6, uint8_t v7, flatbuffers_uint32_vec_ref_t v8
+#define __gpsdo_Profile_call_args ,\
+  v0, v1, v2, v3,\
+  v4, v5, v6, v7, v8
+static inline gpsdo_Profile_ref_t gpsdo_Profile_create(flatbuffers_builder_t *B __gpsdo_Profile_formal_args);
+__flatbuffers_build_table_prolog(flatbuffers_, gpsdo_Profile, gpsdo_Profile_file_identifier, gpsdo_Profile_type_identifier)
+
+#define __gpsdo_kf_smooth_formal_args ,\
+  double v0, uint32_t v1, uint16_t v2, gpsdo_Vec3_ref_t v3,\
+  gpsdo_Vec3_ref_t v4, gpsdo_Vec3_ref_t v5
+#define __gpsdo_kf_smooth_call_args ,\
+  v0, v1, v2, v3,\
+  v4, v5
+static inline gpsdo_kf_smooth_ref_t gpsdo_kf_smooth_create(flatbuffers_builder_t *B __gpsdo_kf_smooth_formal_args);
+__flatbuffers_build_table_prolog(flatbuffers_, gpsdo_kf_smooth, gpsdo_kf_smooth_file_identifier, gpsdo_kf_smooth_type_identifier)
+
 #define __gpsdo_Message_formal_args , double v0, gpsdo_Payload_union_ref_t v2
 #define __gpsdo_Message_call_args , v0, v2
 static inline gpsdo_Message_ref_t gpsdo_Message_create(flatbuffers_builder_t *B __gpsdo_Message_formal_args);
@@ -129,6 +161,10 @@ static inline gpsdo_Payload_union_ref_t gpsdo_Payload_as_Status(gpsdo_Status_ref
 { gpsdo_Payload_union_ref_t uref; uref.type = gpsdo_Payload_Status; uref.value = ref; return uref; }
 static inline gpsdo_Payload_union_ref_t gpsdo_Payload_as_kf_debug(gpsdo_kf_debug_ref_t ref)
 { gpsdo_Payload_union_ref_t uref; uref.type = gpsdo_Payload_kf_debug; uref.value = ref; return uref; }
+static inline gpsdo_Payload_union_ref_t gpsdo_Payload_as_Profile(gpsdo_Profile_ref_t ref)
+{ gpsdo_Payload_union_ref_t uref; uref.type = gpsdo_Payload_Profile; uref.value = ref; return uref; }
+static inline gpsdo_Payload_union_ref_t gpsdo_Payload_as_kf_smooth(gpsdo_kf_smooth_ref_t ref)
+{ gpsdo_Payload_union_ref_t uref; uref.type = gpsdo_Payload_kf_smooth; uref.value = ref; return uref; }
 __flatbuffers_build_union_vector(flatbuffers_, gpsdo_Payload)
 
 static gpsdo_Payload_union_ref_t gpsdo_Payload_clone(flatbuffers_builder_t *B, gpsdo_Payload_union_t u)
@@ -136,6 +172,8 @@ static gpsdo_Payload_union_ref_t gpsdo_Payload_clone(flatbuffers_builder_t *B, g
     switch (u.type) {
     case 1: return gpsdo_Payload_as_Status(gpsdo_Status_clone(B, (gpsdo_Status_table_t)u.value));
     case 2: return gpsdo_Payload_as_kf_debug(gpsdo_kf_debug_clone(B, (gpsdo_kf_debug_table_t)u.value));
+    case 3: return gpsdo_Payload_as_Profile(gpsdo_Profile_clone(B, (gpsdo_Profile_table_t)u.value));
+    case 4: return gpsdo_Payload_as_kf_smooth(gpsdo_kf_smooth_clone(B, (gpsdo_kf_smooth_table_t)u.value));
     default: return gpsdo_Payload_as_NONE();
     }
 }
@@ -147,6 +185,11 @@ __flatbuffers_build_scalar_field(3, flatbuffers_, gpsdo_Status_voltage_control_v
 __flatbuffers_build_scalar_field(4, flatbuffers_, gpsdo_Status_voltage_measured_v, flatbuffers_float, float, 4, 4, 0.00000000f, gpsdo_Status)
 __flatbuffers_build_scalar_field(5, flatbuffers_, gpsdo_Status_temperature_c, flatbuffers_float, float, 4, 4, 0.00000000f, gpsdo_Status)
 __flatbuffers_build_scalar_field(6, flatbuffers_, gpsdo_Status_raw_counter_value, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_Status)
+__flatbuffers_build_table_field(7, flatbuffers_, gpsdo_Status_mode_prob, gpsdo_Vec3, gpsdo_Status)
+__flatbuffers_build_scalar_field(8, flatbuffers_, gpsdo_Status_pps_seq, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_Status)
+__flatbuffers_build_scalar_field(9, flatbuffers_, gpsdo_Status_pps_overruns, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_Status)
+__flatbuffers_build_scalar_field(10, flatbuffers_, gpsdo_Status_pps_backlog_max, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_Status)
+__flatbuffers_build_scalar_field(11, flatbuffers_, gpsdo_Status_pps_sw_reads, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_Status)
 
 static inline gpsdo_Status_ref_t gpsdo_Status_create(flatbuffers_builder_t *B __gpsdo_Status_formal_args)
 {
@@ -157,7 +200,12 @@ static inline gpsdo_Status_ref_t gpsdo_Status_create(flatbuffers_builder_t *B __
         || gpsdo_Status_voltage_control_v_add(B, v3)
         || gpsdo_Status_voltage_measured_v_add(B, v4)
         || gpsdo_Status_temperature_c_add(B, v5)
-        || gpsdo_Status_raw_counter_value_add(B, v6)) {
+        || gpsdo_Status_raw_counter_value_add(B, v6)
+        || gpsdo_Status_mode_prob_add(B, v7)
+        || gpsdo_Status_pps_seq_add(B, v8)
+        || gpsdo_Status_pps_overruns_add(B, v9)
+        || gpsdo_Status_pps_backlog_max_add(B, v10)
+        || gpsdo_Status_pps_sw_reads_add(B, v11)) {
         return 0;
     }
     return gpsdo_Status_end(B);
@@ -173,7 +221,12 @@ static gpsdo_Status_ref_t gpsdo_Status_clone(flatbuffers_builder_t *B, gpsdo_Sta
         || gpsdo_Status_voltage_control_v_pick(B, t)
         || gpsdo_Status_voltage_measured_v_pick(B, t)
         || gpsdo_Status_temperature_c_pick(B, t)
-        || gpsdo_Status_raw_counter_value_pick(B, t)) {
+        || gpsdo_Status_raw_counter_value_pick(B, t)
+        || gpsdo_Status_mode_prob_pick(B, t)
+        || gpsdo_Status_pps_seq_pick(B, t)
+        || gpsdo_Status_pps_overruns_pick(B, t)
+        || gpsdo_Status_pps_backlog_max_pick(B, t)
+        || gpsdo_Status_pps_sw_reads_pick(B, t)) {
         return 0;
     }
     __flatbuffers_memoize_end(B, t, gpsdo_Status_end(B));
@@ -338,6 +391,8 @@ __flatbuffers_build_table_field(5, flatbuffers_, gpsdo_kf_debug_q, gpsdo_Mat3x3,
 __flatbuffers_build_scalar_field(6, flatbuffers_, gpsdo_kf_debug_r, flatbuffers_float, float, 4, 4, 0.00000000f, gpsdo_kf_debug)
 __flatbuffers_build_scalar_field(7, flatbuffers_, gpsdo_kf_debug_outlier_count, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_kf_debug)
 __flatbuffers_build_scalar_field(8, flatbuffers_, gpsdo_kf_debug_kf_iteration, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_kf_debug)
+__flatbuffers_build_scalar_field(9, flatbuffers_, gpsdo_kf_debug_cov_health_count, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_kf_debug)
+__flatbuffers_build_scalar_field(10, flatbuffers_, gpsdo_kf_debug_reacq_count, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_kf_debug)
 
 static inline gpsdo_kf_debug_ref_t gpsdo_kf_debug_create(flatbuffers_builder_t *B __gpsdo_kf_debug_formal_args)
 {
@@ -350,7 +405,9 @@ static inline gpsdo_kf_debug_ref_t gpsdo_kf_debug_create(flatbuffers_builder_t *
         || gpsdo_kf_debug_q_add(B, v5)
         || gpsdo_kf_debug_r_add(B, v6)
         || gpsdo_kf_debug_outlier_count_add(B, v7)
-        || gpsdo_kf_debug_kf_iteration_add(B, v8)) {
+        || gpsdo_kf_debug_kf_iteration_add(B, v8)
+        || gpsdo_kf_debug_cov_health_count_add(B, v9)
+        || gpsdo_kf_debug_reacq_count_add(B, v10)) {
         return 0;
     }
     return gpsdo_kf_debug_end(B);
@@ -368,16 +425,101 @@ static gpsdo_kf_debug_ref_t gpsdo_kf_debug_clone(flatbuffers_builder_t *B, gpsdo
         || gpsdo_kf_debug_q_pick(B, t)
         || gpsdo_kf_debug_r_pick(B, t)
         || gpsdo_kf_debug_outlier_count_pick(B, t)
-        || gpsdo_kf_debug_kf_iteration_pick(B, t)) {
+        || gpsdo_kf_debug_kf_iteration_pick(B, t)
+        || gpsdo_kf_debug_cov_health_count_pick(B, t)
+        || gpsdo_kf_debug_reacq_count_pick(B, t)) {
         return 0;
     }
     __flatbuffers_memoize_end(B, t, gpsdo_kf_debug_end(B));
 }
 
+__flatbuffers_build_scalar_field(0, flatbuffers_, gpsdo_Profile_section, flatbuffers_uint8, uint8_t, 1, 1, UINT8_C(0), gpsdo_Profile)
+__flatbuffers_build_scalar_field(1, flatbuffers_, gpsdo_Profile_cpu_hz, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_Profile)
+__flatbuffers_build_scalar_field(2, flatbuffers_, gpsdo_Profile_count, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_Profile)
+__flatbuffers_build_scalar_field(3, flatbuffers_, gpsdo_Profile_min_cycles, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_Profile)
+__flatbuffers_build_scalar_field(4, flatbuffers_, gpsdo_Profile_max_cycles, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_Profile)
+__flatbuffers_build_scalar_field(5, flatbuffers_, gpsdo_Profile_mean_cycles, flatbuffers_float, float, 4, 4, 0.00000000f, gpsdo_Profile)
+__flatbuffers_build_scalar_field(6, flatbuffers_, gpsdo_Profile_last_cycles, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_Profile)
+__flatbuffers_build_scalar_field(7, flatbuffers_, gpsdo_Profile_hist_first_bucket, flatbuffers_uint8, uint8_t, 1, 1, UINT8_C(0), gpsdo_Profile)
+__flatbuffers_build_vector_field(8, flatbuffers_, gpsdo_Profile_hist, flatbuffers_uint32, uint32_t, gpsdo_Profile)
+
+static inline gpsdo_Profile_ref_t gpsdo_Profile_create(flatbuffers_builder_t *B __gpsdo_Profile_formal_args)
+{
+    if (gpsdo_Profile_start(B)
+        || gpsdo_Profile_section_add(B, v0)
+        || gpsdo_Profile_cpu_hz_add(B, v1)
+        || gpsdo_Profile_count_add(B, v2)
+        || gpsdo_Profile_min_cycles_add(B, v3)
+        || gpsdo_Profile_max_cycles_add(B, v4)
+        || gpsdo_Profile_mean_cycles_add(B, v5)
+        || gpsdo_Profile_last_cycles_add(B, v6)
+        || gpsdo_Profile_hist_first_bucket_add(B, v7)
+        || gpsdo_Profile_hist_add(B, v8)) {
+        return 0;
+    }
+    return gpsdo_Profile_end(B);
+}
+
+static gpsdo_Profile_ref_t gpsdo_Profile_clone(flatbuffers_builder_t *B, gpsdo_Profile_table_t t)
+{
+    __flatbuffers_memoize_begin(B, t);
+    if (gpsdo_Profile_start(B)
+        || gpsdo_Profile_section_pick(B, t)
+        || gpsdo_Profile_cpu_hz_pick(B, t)
+        || gpsdo_Profile_count_pick(B, t)
+        || gpsdo_Profile_min_cycles_pick(B, t)
+        || gpsdo_Profile_max_cycles_pick(B, t)
+        || gpsdo_Profile_mean_cycles_pick(B, t)
+        || gpsdo_Profile_last_cycles_pick(B, t)
+        || gpsdo_Profile_hist_first_bucket_pick(B, t)
+        || gpsdo_Profile_hist_pick(B, t)) {
+        return 0;
+    }
+    __flatbuffers_memoize_end(B, t, gpsdo_Profile_end(B));
+}
+
+__flatbuffers_build_scalar_field(0, flatbuffers_, gpsdo_kf_smooth_timestamp_s, flatbuffers_double, double, 8, 8, 0.0000000000000000, gpsdo_kf_smooth)
+__flatbuffers_build_scalar_field(1, flatbuffers_, gpsdo_kf_smooth_kf_iteration, flatbuffers_uint32, uint32_t, 4, 4, UINT32_C(0), gpsdo_kf_smooth)
+__flatbuffers_build_scalar_field(2, flatbuffers_, gpsdo_kf_smooth_lag, flatbuffers_uint16, uint16_t, 2, 2, UINT16_C(0), gpsdo_kf_smooth)
+__flatbuffers_build_table_field(3, flatbuffers_, gpsdo_kf_smooth_x, gpsdo_Vec3, gpsdo_kf_smooth)
+__flatbuffers_build_table_field(4, flatbuffers_, gpsdo_kf_smooth_sigma, gpsdo_Vec3, gpsdo_kf_smooth)
+__flatbuffers_build_table_field(5, flatbuffers_, gpsdo_kf_smooth_x_filt, gpsdo_Vec3, gpsdo_kf_smooth)
+
+static inline gpsdo_kf_smooth_ref_t gpsdo_kf_smooth_create(flatbuffers_builder_t *B __gpsdo_kf_smooth_formal_args)
+{
+    if (gpsdo_kf_smooth_start(B)
+        || gpsdo_kf_smooth_timestamp_s_add(B, v0)
+        || gpsdo_kf_smooth_x_add(B, v3)
+        || gpsdo_kf_smooth_sigma_add(B, v4)
+        || gpsdo_kf_smooth_x_filt_add(B, v5)
+        || gpsdo_kf_smooth_kf_iteration_add(B, v1)
+        || gpsdo_kf_smooth_lag_add(B, v2)) {
+        return 0;
+    }
+    return gpsdo_kf_smooth_end(B);
+}
+
+static gpsdo_kf_smooth_ref_t gpsdo_kf_smooth_clone(flatbuffers_builder_t *B, gpsdo_kf_smooth_table_t t)
+{
+    __flatbuffers_memoize_begin(B, t);
+    if (gpsdo_kf_smooth_start(B)
+        || gpsdo_kf_smooth_timestamp_s_pick(B, t)
+        || gpsdo_kf_smooth_x_pick(B, t)
+        || gpsdo_kf_smooth_sigma_pick(B, t)
+        || gpsdo_kf_smooth_x_filt_pick(B, t)
+        || gpsdo_kf_smooth_kf_iteration_pick(B, t)
+        || gpsdo_kf_smooth_lag_pick(B, t)) {
+        return 0;
+    }
+    __flatbuffers_memoize_end(B, t, gpsdo_kf_smooth_end(B));
+}
+
 __flatbuffers_build_scalar_field(0, flatbuffers_, gpsdo_Message_timestamp_s, flatbuffers_double, double, 8, 8, 0.0000000000000000, gpsdo_Message)
 __flatbuffers_build_union_field(2, flatbuffers_, gpsdo_Message_payload, gpsdo_Payload, gpsdo_Message)
 __flatbuffers_build_union_table_value_field(flatbuffers_, gpsdo_Message_payload, gpsdo_Payload, Status, gpsdo_Status)
 __flatbuffers_build_union_table_value_field(flatbuffers_, gpsdo_Message_payload, gpsdo_Payload, kf_debug, gpsdo_kf_debug)
+__flatbuffers_build_union_table_value_field(flatbuffers_, gpsdo_Message_payload, gpsdo_Payload, Profile, gpsdo_Profile)
+__flatbuffers_build_union_table_value_field(flatbuffers_, gpsdo_Message_payload, gpsdo_Payload, kf_smooth, gpsdo_kf_smooth)
 
 static inline gpsdo_Message_ref_t gpsdo_Message_create(flatbuffers_builder_t *B __gpsdo_Message_formal_args)
 {
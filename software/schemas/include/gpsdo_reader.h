@@ -51,6 +51,14 @@ typedef const struct gpsdo_kf_debug_table *gpsdo_kf_debug_table_t;
 typedef struct gpsdo_kf_debug_table *gpsdo_kf_debug_mutable_table_t;
 typedef const flatbuffers_uoffset_t *gpsdo_kf_debug_vec_t;
 typedef flatbuffers_uoffset_t *gpsdo_kf_debug_mutable_vec_t;
+typedef const struct gpsdo_Profile_table *gpsdo_Profile_table_t;
+typedef struct gpsdo_Profile_table *gpsdo_Profile_mutable_table_t;
+typedef const flatbuffers_uoffset_t *gpsdo_Profile_vec_t;
+typedef flatbuffers_uoffset_t *gpsdo_Profile_mutable_vec_t;
+typedef const struct gpsdo_kf_smooth_table *gpsdo_kf_smooth_table_t;
+typedef struct gpsdo_kf_smooth_table *gpsdo_kf_smooth_mutable_table_t;
+typedef const flatbuffers_uoffset_t *gpsdo_kf_smooth_vec_t;
+typedef flatbuffers_uoffset_t *gpsdo_kf_smooth_mutable_vec_t;
 typedef const struct gpsdo_Message_table *gpsdo_Message_table_t;
 typedef struct gpsdo_Message_table *gpsdo_Message_mutable_table_t;
 typedef const flatbuffers_uoffset_t *gpsdo_Message_vec_t;
@@ -151,6 +159,30 @@ typedef flatbuffers_uoffset_t *gpsdo_Message_mutable_vec_t;
 #ifndef gpsdo_kf_debug_file_extension
 #define gpsdo_kf_debug_file_extension "bin"
 #endif
+#ifndef gpsdo_Profile_file_identifier
+#define gpsdo_Profile_file_identifier 0
+#endif
+/* deprecated, use gpsdo_Profile_file_identifier */
+#ifndef gpsdo_Profile_identifier
+#define gpsdo_Profile_identifier 0
+#endif
+#define gpsdo_Profile_type_hash ((flatbuffers_thash_t)0x13cf0335)
+#define gpsdo_Profile_type_identifier "\x35\x03\xcf\x13"
+#ifndef gpsdo_Profile_file_extension
+#define gpsdo_Profile_file_extension "bin"
+#endif
+#ifndef gpsdo_kf_smooth_file_identifier
+#define gpsdo_kf_smooth_file_identifier 0
+#endif
+/* deprecated, use gpsdo_kf_smooth_file_identifier */
+#ifndef gpsdo_kf_smooth_identifier
+#define gpsdo_kf_smooth_identifier 0
+#endif
+#define gpsdo_kf_smooth_type_hash ((flatbuffers_thash_t)0xd003f368)
+#define gpsdo_kf_smooth_type_identifier "\x68\xf3\x03\xd0"
+#ifndef gpsdo_kf_smooth_file_extension
+#define gpsdo_kf_smooth_file_extension "bin"
+#endif
 #ifndef gpsdo_Message_file_identifier
 #define gpsdo_Message_file_identifier 0
 #endif
@@ -181,6 +213,11 @@ __flatbuffers_define_scalar_field(3, gpsdo_Status, voltage_control_v, flatbuffer
 __flatbuffers_define_scalar_field(4, gpsdo_Status, voltage_measured_v, flatbuffers_float, float, 0.00000000f)
 __flatbuffers_define_scalar_field(5, gpsdo_Status, temperature_c, flatbuffers_float, float, 0.00000000f)
 __flatbuffers_define_scalar_field(6, gpsdo_Status, raw_counter_value, flatbuffers_uint32, uint32_t, UINT32_C(0))
+__flatbuffers_define_table_field(7, gpsdo_Status, mode_prob, gpsdo_Vec3_table_t, 0)
+__flatbuffers_define_scalar_field(8, gpsdo_Status, pps_seq, flatbuffers_uint32, uint32_t, UINT32_C(0))
+__flatbuffers_define_scalar_field(9, gpsdo_Status, pps_overruns, flatbuffers_uint32, uint32_t, UINT32_C(0))
+__flatbuffers_define_scalar_field(10, gpsdo_Status, pps_backlog_max, flatbuffers_uint32, uint32_t, UINT32_C(0))
+__flatbuffers_define_scalar_field(11, gpsdo_Status, pps_sw_reads, flatbuffers_uint32, uint32_t, UINT32_C(0))
 
 struct gpsdo_Mat3x3_table { uint8_t unused__; };
 
@@ -267,12 +304,49 @@ __flatbuffers_define_table_field(5, gpsdo_kf_debug, q, gpsdo_Mat3x3_table_t, 0)
 __flatbuffers_define_scalar_field(6, gpsdo_kf_debug, r, flatbuffers_float, float, 0.00000000f)
 __flatbuffers_define_scalar_field(7, gpsdo_kf_debug, outlier_count, flatbuffers_uint32, uint32_t, UINT32_C(0))
 __flatbuffers_define_scalar_field(8, gpsdo_kf_debug, kf_iteration, flatbuffers_uint32, uint32_t, UINT32_C(0))
+__flatbuffers_define_scalar_field(9, gpsdo_kf_debug, cov_health_count, flatbuffers_uint32, uint32_t, UINT32_C(0))
+__flatbuffers_define_scalar_field(10, gpsdo_kf_debug, reacq_count, flatbuffers_uint32, uint32_t, UINT32_C(0))
+
+struct gpsdo_Profile_table { uint8_t unused__; };
+
+static inline size_t gpsdo_Profile_vec_len(gpsdo_Profile_vec_t vec)
+__flatbuffers_vec_len(vec)
+static inline gpsdo_Profile_table_t gpsdo_Profile_vec_at(gpsdo_Profile_vec_t vec, size_t i)
+__flatbuffers_offset_vec_at(gpsdo_Profile_table_t, vec, i, 0)
+__flatbuffers_table_as_root(gpsdo_Profile)
+
+__flatbuffers_define_scalar_field(0, gpsdo_Profile, section, flatbuffers_uint8, uint8_t, UINT8_C(0))
+__flatbuffers_define_scalar_field(1, gpsdo_Profile, cpu_hz, flatbuffers_uint32, uint32_t, UINT32_C(0))
+__flatbuffers_define_scalar_field(2, gpsdo_Profile, count, flatbuffers_uint32, uint32_t, UINT32_C(0))
+__flatbuffers_define_scalar_field(3, gpsdo_Profile, min_cycles, flatbuffers_uint32, uint32_t, UINT32_C(0))
+__flatbuffers_define_scalar_field(4, gpsdo_Profile, max_cycles, flatbuffers_uint32, uint32_t, UINT32_C(0))
+__flatbuffers_define_scalar_field(5, gpsdo_Profile, mean_cycles, flatbuffers_float, float, 0.00000000f)
+__flatbuffers_define_scalar_field(6, gpsdo_Profile, last_cycles, flatbuffers_uint32, uint32_t, UINT32_C(0))
+__flatbuffers_define_scalar_field(7, gpsdo_Profile, hist_first_bucket, flatbuffers_uint8, uint8_t, UINT8_C(0))
+__flatbuffers_define_vector_field(8, gpsdo_Profile, hist, flatbuffers_uint32_vec_t, 0)
+
+struct gpsdo_kf_smooth_table { uint8_t unused__; };
+
+static inline size_t gpsdo_kf_smooth_vec_len(gpsdo_kf_smooth_vec_t vec)
+__flatbuffers_vec_len(vec)
+static inline gpsdo_kf_smooth_table_t gpsdo_kf_smooth_vec_at(gpsdo_kf_smooth_vec_t vec, size_t i)
+__flatbuffers_offset_vec_at(gpsdo_kf_smooth_table_t, vec, i, 0)
+__flatbuffers_table_as_root(gpsdo_kf_smooth)
+
+__flatbuffers_define_scalar_field(0, gpsdo_kf_smooth, timestamp_s, flatbuffers_double, double, 0.0000000000000000)
+__flatbuffers_define_scalar_field(1, gpsdo_kf_smooth, kf_iteration, flatbuffers_uint32, uint32_t, UINT32_C(0))
+__flatbuffers_define_scalar_field(2, gpsdo_kf_smooth, lag, flatbuffers_uint16, uint16_t, UINT16_C(0))
+__flatbuffers_define_table_field(3, gpsdo_kf_smooth, x, gpsdo_Vec3_table_t, 0)
+__flatbuffers_define_table_field(4, gpsdo_kf_smooth, sigma, gpsdo_Vec3_table_t, 0)
+__flatbuffers_define_table_field(5, gpsdo_kf_smooth, x_filt, gpsdo_Vec3_table_t, 0)
 typedef uint8_t gpsdo_Payload_union_type_t;
 __flatbuffers_define_integer_type(gpsdo_Payload, gpsdo_Payload_union_type_t, 8)
 __flatbuffers_define_union(flatbuffers_, gpsdo_Payload)
 #define gpsdo_Payload_NONE ((gpsdo_Payload_union_type_t)UINT8_C(0))
 #define gpsdo_Payload_Status ((gpsdo_Payload_union_type_t)UINT8_C(1))
 #define gpsdo_Payload_kf_debug ((gpsdo_Payload_union_type_t)UINT8_C(2))
+#define gpsdo_Payload_Profile ((gpsdo_Payload_union_type_t)UINT8_C(3))
+#define gpsdo_Payload_kf_smooth ((gpsdo_Payload_union_type_t)UINT8_C(4))
 
 static inline const char *gpsdo_Payload_type_name(gpsdo_Payload_union_type_t type)
 {
@@ -280,6 +354,8 @@ static inline const char *gpsdo_Payload_type_name(gpsdo_Payload_union_type_t typ
     case gpsdo_Payload_NONE: return "NONE";
     case gpsdo_Payload_Status: return "Status";
     case gpsdo_Payload_kf_debug: return "kf_debug";
+    case gpsdo_Payload_Profile: return "Profile";
+    case gpsdo_Payload_kf_smooth: return "kf_smooth";
     default: return "";
     }
 }
@@ -290,6 +366,8 @@ static inline int gpsdo_Payload_is_known_type(gpsdo_Payload_union_type_t type)
     case gpsdo_Payload_NONE: return 1;
     case gpsdo_Payload_Status: return 1;
     case gpsdo_Payload_kf_debug: return 1;
+    case gpsdo_Payload_Profile: return 1;
+    case gpsdo_Payload_kf_smooth: return 1;
     default: return 0;
     }
 }
@@ -17,6 +17,8 @@ static int gpsdo_Mat3x1_verify_table(flatcc_table_verifier_descriptor_t *td);
 static int gpsdo_kf_correction_debug_verify_table(flatcc_table_verifier_descriptor_t *td);
 static int gpsdo_kf_state_debug_verify_table(flatcc_table_verifier_descriptor_t *td);
 static int gpsdo_kf_debug_verify_table(flatcc_table_verifier_descriptor_t *td);
+static int gpsdo_Profile_verify_table(flatcc_table_verifier_descriptor_t *td);
+static int gpsdo_kf_smooth_verify_table(flatcc_table_verifier_descriptor_t *td);
 static int gpsdo_Message_verify_table(flatcc_table_verifier_descriptor_t *td);
 
 static int gpsdo_Payload_union_verifier(flatcc_union_verifier_descriptor_t *ud)
@@ -24,6 +26,8 @@ static int gpsdo_Payload_union_verifier(flatcc_union_verifier_descriptor_t *ud)
     switch (ud->type) {
     case 1: return flatcc_verify_union_table(ud, gpsdo_Status_verify_table); /* Status */
     case 2: return flatcc_verify_union_table(ud, gpsdo_kf_debug_verify_table); /* kf_debug */
+    case 3: return flatcc_verify_union_table(ud, gpsdo_Profile_verify_table); /* Profile */
+    case 4: return flatcc_verify_union_table(ud, gpsdo_kf_smooth_verify_table); /* kf_smooth */
     default: return flatcc_verify_ok;
     }
 }
@@ -38,6 +42,11 @@ static int gpsdo_Status_verify_table(flatcc_table_verifier_descriptor_t *td)
     if ((ret = flatcc_verify_field(td, 4, 4, 4) /* voltage_measured_v */)) return ret;
     if ((ret = flatcc_verify_field(td, 5, 4, 4) /* temperature_c */)) return ret;
     if ((ret = flatcc_verify_field(td, 6, 4, 4) /* raw_counter_value */)) return ret;
+    if ((ret = flatcc_verify_table_field(td, 7, 0, &gpsdo_Vec3_verify_table) /* mode_prob */)) return ret;
+    if ((ret = flatcc_verify_field(td, 8, 4, 4) /* pps_seq */)) return ret;
+    if ((ret = flatcc_verify_field(td, 9, 4, 4) /* pps_overruns */)) return ret;
+    if ((ret = flatcc_verify_field(td, 10, 4, 4) /* pps_backlog_max */)) return ret;
+    if ((ret = flatcc_verify_field(td, 11, 4, 4) /* pps_sw_reads */)) return ret;
     return flatcc_verify_ok;
 }
 
@@ -383,6 +392,8 @@ static int gpsdo_kf_debug_verify_table(flatcc_table_verifier_descriptor_t *td)
     if ((ret = flatcc_verify_field(td, 6, 4, 4) /* r */)) return ret;
     if ((ret = flatcc_verify_field(td, 7, 4, 4) /* outlier_count */)) return ret;
     if ((ret = flatcc_verify_field(td, 8, 4, 4) /* kf_iteration */)) return ret;
+    if ((ret = flatcc_verify_field(td, 9, 4, 4) /* cov_health_count */)) return ret;
+    if ((ret = flatcc_verify_field(td, 10, 4, 4) /* reacq_count */)) return ret;
     return flatcc_verify_ok;
 }
 
@@ -426,6 +437,113 @@ static inline int gpsdo_kf_debug_verify_as_root_with_type_hash_and_size(const vo
     return flatcc_verify_table_as_typed_root_with_size(buf, bufsiz, thash, &gpsdo_kf_debug_verify_table);
 }
 
+static int gpsdo_Profile_verify_table(flatcc_table_verifier_descriptor_t *td)
+{
+    int ret;
+    if ((ret = flatcc_verify_field(td, 0, 1, 1) /* section */)) return ret;
+    if ((ret = flatcc_verify_field(td, 1, 4, 4) /* cpu_hz */)) return ret;
+    if ((ret = flatcc_verify_field(td, 2, 4, 4) /* count */)) return ret;
+    if ((ret = flatcc_verify_field(td, 3, 4, 4) /* min_cycles */)) return ret;
+    if ((ret = flatcc_verify_field(td, 4, 4, 4) /* max_cycles */)) return ret;
+    if ((ret = flatcc_verify_field(td, 5, 4, 4) /* mean_cycles */)) return ret;
+    if ((ret = flatcc_verify_field(td, 6, 4, 4) /* last_cycles */)) return ret;
+    if ((ret = flatcc_verify_field(td, 7, 1, 1) /* hist_first_bucket */)) return ret;
+    if ((ret = flatcc_verify_vector_field(td, 8, 0, 4, 4, INT64_C(1073741823)) /* hist */)) return ret;
+    return flatcc_verify_ok;
+}
+
+static inline int gpsdo_Profile_verify_as_root(const void *buf, size_t bufsiz)
+{
+    return flatcc_verify_table_as_root(buf, bufsiz, gpsdo_Profile_identifier, &gpsdo_Profile_verify_table);
+}
+
+static inline int gpsdo_Profile_verify_as_root_with_size(const void *buf, size_t bufsiz)
+{
+    return flatcc_verify_table_as_root_with_size(buf, bufsiz, gpsdo_Profile_identifier, &gpsdo_Profile_verify_table);
+}
+
+static inline int gpsdo_Profile_verify_as_typed_root(const void *buf, size_t bufsiz)
+{
+    return flatcc_verify_table_as_root(buf, bufsiz, gpsdo_Profile_type_identifier, &gpsdo_Profile_verify_table);
+}
+
+static inline int gpsdo_Profile_verify_as_typed_root_with_size(const void *buf, size_t bufsiz)
+{
+    return flatcc_verify_table_as_root_with_size(buf, bufsiz, gpsdo_Profile_type_identifier, &gpsdo_Profile_verify_table);
+}
+
+static inline int gpsdo_Profile_verify_as_root_with_identifier(const void *buf, size_t bufsiz, const char *fid)
+{
+    return flatcc_verify_table_as_root(buf, bufsiz, fid, &gpsdo_Profile_verify_table);
+}
+
+static inline int gpsdo_Profile_verify_as_root_with_identifier_and_size(const void *buf, size_t bufsiz, const char *fid)
+{
+    return flatcc_verify_table_as_root_with_size(buf, bufsiz, fid, &gpsdo_Profile_verify_table);
+}
+
+static inline int gpsdo_Profile_verify_as_root_with_type_hash(const void *buf, size_t bufsiz, flatbuffers_thash_t thash)
+{
+    return flatcc_verify_table_as_typed_root(buf, bufsiz, thash, &gpsdo_Profile_verify_table);
+}
+
+static inline int gpsdo_Profile_verify_as_root_with_type_hash_and_size(const void *buf, size_t bufsiz, flatbuffers_thash_t thash)
+{
+    return flatcc_verify_table_as_typed_root_with_size(buf, bufsiz, thash, &gpsdo_Profile_verify_table);
+}
+
+static int gpsdo_kf_smooth_verify_table(flatcc_table_verifier_descriptor_t *td)
+{
+    int ret;
+    if ((ret = flatcc_verify_field(td, 0, 8, 8) /* timestamp_s */)) return ret;
+    if ((ret = flatcc_verify_field(td, 1, 4, 4) /* kf_iteration */)) return ret;
+    if ((ret = flatcc_verify_field(td, 2, 2, 2) /* lag */)) return ret;
+    if ((ret = flatcc_verify_table_field(td, 3, 0, &gpsdo_Vec3_verify_table) /* x */)) return ret;
+    if ((ret = flatcc_verify_table_field(td, 4, 0, &gpsdo_Vec3_verify_table) /* sigma */)) return ret;
+    if ((ret = flatcc_verify_table_field(td, 5, 0, &gpsdo_Vec3_verify_table) /* x_filt */)) return ret;
+    return flatcc_verify_ok;
+}
+
+static inline int gpsdo_kf_smooth_verify_as_root(const void *buf, size_t bufsiz)
+{
+    return flatcc_verify_table_as_root(buf, bufsiz, gpsdo_kf_smooth_identifier, &gpsdo_kf_smooth_verify_table);
+}
+
+static inline int gpsdo_kf_smooth_verify_as_root_with_size(const void *buf, size_t bufsiz)
+{
+    return flatcc_verify_table_as_root_with_size(buf, bufsiz, gpsdo_kf_smooth_identifier, &gpsdo_kf_smooth_verify_table);
+}
+
+static inline int gpsdo_kf_smooth_verify_as_typed_root(const void *buf, size_t bufsiz)
+{
+    return flatcc_verify_table_as_root(buf, bufsiz, gpsdo_kf_smooth_type_identifier, &gpsdo_kf_smooth_verify_table);
+}
+
+static inline int gpsdo_kf_smooth_verify_as_typed_root_with_size(const void *buf, size_t bufsiz)
+{
+    return flatcc_verify_table_as_root_with_size(buf, bufsiz, gpsdo_kf_smooth_type_identifier, &gpsdo_kf_smooth_verify_table);
+}
+
+static inline int gpsdo_kf_smooth_verify_as_root_with_identifier(const void *buf, size_t bufsiz, const char *fid)
+{
+    return flatcc_verify_table_as_root(buf, bufsiz, fid, &gpsdo_kf_smooth_verify_table);
+}
+
+static inline int gpsdo_kf_smooth_verify_as_root_with_identifier_and_size(const void *buf, size_t bufsiz, const char *fid)
+{
+    return flatcc_verify_table_as_root_with_size(buf, bufsiz, fid, &gpsdo_kf_smooth_verify_table);
+}
+
+static inline int gpsdo_kf_smooth_verify_as_root_with_type_hash(const void *buf, size_t bufsiz, flatbuffers_thash_t thash)
+{
+    return flatcc_verify_table_as_typed_root(buf, bufsiz, thash, &gpsdo_kf_smooth_verify_table);
+}
+
+static inline int gpsdo_kf_smooth_verify_as_root_with_type_hash_and_size(const void *buf, size_t bufsiz, flatbuffers_thash_t thash)
+{
+    return flatcc_verify_table_as_typed_root_with_size(buf, bufsiz, thash, &gpsdo_kf_smooth_verify_table);
+}
+
 static int gpsdo_Message_verify_table(flatcc_table_verifier_descriptor_t *td)
 {
     int ret;
@@ -4,6 +4,8 @@ import argparse
 from typing import Optional
 import logging
 
+import serial
+
 log = logging.getLogger(__name__)
 
 from serial_utils import open_serial_for_vid
@@ -11,18 +13,25 @@ from reader import read_loop
 
 def main(argv: Optional[list] = None):
     parser = argparse.ArgumentParser()
-    parser.add_argument("--vid", required=True, help="Vendor ID (e.g. 0x0483)")
+    parser.add_argument("--vid", help="Vendor ID (e.g. 0x0483)")
     parser.add_argument("--pid", help="Product ID (e.g. 0x5740)")
     parser.add_argument("--product", help="Product substring to match")
     parser.add_argument("--baud", type=int, default=115200)
     parser.add_argument("--timeout", type=float, default=1.0)
+    parser.add_argument("--port", help="Serial device path, e.g. the gpsdo_vdev PTY")
     
     args = parser.parse_args(argv)
 
-    vid = int(args.vid, 0)
-    pid = int(args.pid, 0) if args.pid else None
+    if args.port:
+        ser = serial.Serial(args.port, baudrate=args.baud, timeout=args.timeout)
+        log.info("Opened serial %s @ %d", args.port, args.baud)
+    else:
+        if not args.vid:
+            parser.error("--vid or --port is required")
+        vid = int(args.vid, 0)
+        pid = int(args.pid, 0) if args.pid else None
 
-    ser = open_serial_for_vid(vid, pid=pid, product=args.product, baud=args.baud, timeout=args.timeout)
+        ser = open_serial_for_vid(vid, pid=pid, product=args.product, baud=args.baud, timeout=args.timeout)
 
     read_loop(ser, log)
 
@@ -42,5 +51,5 @@ if __name__ == "__main__":
     # Default VID/PID if none given
     VID = "0x0483"
     PID = "0x5740"
-    argv = ["--vid", VID, "--pid", PID]
+    argv = sys.argv[1:] or ["--vid", VID, "--pid", PID]
     main(argv)
\ No newline at end of file
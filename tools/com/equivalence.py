@@ -0,0 +1,263 @@
+"""
+Numerical equivalence check between the firmware filter (filter.c, float32,
+built as libgpsdo_filter by software/host) and kalman.py (float64 NumPy).
+
+Both filters replay the same raw_counter_value stream with the same
+q / sigma_phase / Mahalanobis threshold. Per step the divergence of the
+state X, covariance P, gain K and innovation y is checked against
+|c - py| <= atol + rtol * |py|.
+
+usage: python equivalence.py logs/<log>.csv [--lib build-host/libgpsdo_filter.so]
+"""
+
+import argparse
+import csv
+import ctypes
+import os
+import sys
+import time
+
+import numpy as np
+
+from kalman import KalmanFilter
+
+REPO_ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+DEFAULT_LIB = os.path.join(REPO_ROOT, "build-host", "libgpsdo_filter.so")
+
+# rtol, atol per quantity
+DEFAULT_TOL = {
+    "x": (1e-4, 1e-5),
+    "P": (1e-3, 1e-9),
+    "K": (1e-3, 1e-7),
+    "y": (1e-4, 1e-4),
+}
+
+
+# filter_kernel_t order
+KERNELS = ("sym", "cmsis")
+
+
+class FilterConfig(ctypes.Structure):
+    """filter_config_t (filter.h), field for field."""
+    _fields_ = [
+        ("q", ctypes.c_float),
+        ("sigma_phase", ctypes.c_float),
+        ("mahal_threshold", ctypes.c_float),
+        ("kernel", ctypes.c_int),           # filter_kernel_t
+        ("steady_state", ctypes.c_bool),
+        ("joseph", ctypes.c_bool),
+        ("adaptive", ctypes.c_bool),
+        ("imm", ctypes.c_bool),
+        ("reacq_run", ctypes.c_uint16),
+        ("control_input", ctypes.c_bool),
+        ("init_samples", ctypes.c_uint16),
+    ]
+
+
+class FirmwareFilter:
+    """ctypes wrapper around filter_trace_run() in libgpsdo_filter."""
+
+    def __init__(self, path):
+        self.lib = ctypes.CDLL(path)
+
+        f32p = np.ctypeslib.ndpointer(np.float32, flags="C_CONTIGUOUS")
+        self.lib.filter_trace_run.restype = ctypes.c_uint32
+        self.lib.filter_trace_run.argtypes = [
+            np.ctypeslib.ndpointer(np.float64, flags="C_CONTIGUOUS"),
+            ctypes.c_uint32,
+            f32p, f32p, f32p, f32p, f32p,
+            np.ctypeslib.ndpointer(np.uint8, flags="C_CONTIGUOUS"),
+        ]
+        self.lib.filter_trace_config_size.restype = ctypes.c_uint32
+        self.lib.filter_trace_config_size.argtypes = []
+        self.lib.filter_trace_get_config.restype = None
+        self.lib.filter_trace_get_config.argtypes = [ctypes.POINTER(FilterConfig)]
+        self.lib.filter_trace_set_config.restype = None
+        self.lib.filter_trace_set_config.argtypes = [ctypes.POINTER(FilterConfig)]
+
+        size = self.lib.filter_trace_config_size()
+        if size != ctypes.sizeof(FilterConfig):
+            raise RuntimeError(f"filter_config_t is {size} bytes, FilterConfig "
+                               f"{ctypes.sizeof(FilterConfig)}: update equivalence.py")
+
+    def config(self):
+        cfg = FilterConfig()
+        self.lib.filter_trace_get_config(ctypes.byref(cfg))
+        return cfg
+
+    def set_config(self, cfg):
+        self.lib.filter_trace_set_config(ctypes.byref(cfg))
+
+    def run(self, raw):
+        n = len(raw)
+        out = {
+            "x": np.zeros((n, 3), np.float32),
+            "P": np.zeros((n, 9), np.float32),
+            "K": np.zeros((n, 3), np.float32),
+            "y": np.zeros(n, np.float32),
+            "S": np.zeros(n, np.float32),
+            "rejected": np.zeros(n, np.uint8),
+        }
+        self.lib.filter_trace_run(np.ascontiguousarray(raw, np.float64), n,
+                                  out["x"], out["P"], out["K"], out["y"], out["S"],
+                                  out["rejected"])
+        out["rejected"] = out["rejected"].astype(bool)
+        return out
+
+
+def run_python(raw, q, sigma_phase, mahal_thd):
+    kf = KalmanFilter(q=q, sigma_phase=sigma_phase, mahal_thd=mahal_thd)
+    n = len(raw)
+    out = {
+        "x": np.zeros((n, 3)),
+        "P": np.zeros((n, 9)),
+        "K": np.zeros((n, 3)),
+        "y": np.zeros(n),
+        "rejected": np.zeros(n, bool),
+    }
+    outliers = 0
+    for i, count in enumerate(raw):
+        kf.predict()
+        x, P, K, y = kf.update(count)
+        out["x"][i] = x
+        out["P"][i] = P.ravel()
+        out["K"][i] = K.ravel()
+        out["y"][i] = y[0]
+        out["rejected"][i] = kf.outlier_cnt != outliers
+        outliers = kf.outlier_cnt
+    return out
+
+
+def load_raw_counts(path):
+    with open(path, newline="") as f:
+        reader = csv.DictReader(f)
+        return np.array([float(row["raw_counter_value"]) for row in reader])
+
+
+def divergence(c, py, rtol, atol):
+    """Per step max |c - py| and max excess over the tolerance band."""
+    c = np.asarray(c, np.float64).reshape(len(c), -1)
+    py = np.asarray(py, np.float64).reshape(len(py), -1)
+    err = np.abs(c - py)
+    excess = err - (atol + rtol * np.abs(py))
+    return err.max(axis=1), excess.max(axis=1)
+
+
+def parse_tol(items):
+    tol = dict(DEFAULT_TOL)
+    for item in items or []:
+        name, _, val = item.partition("=")
+        rtol, _, atol = val.partition(":")
+        if name not in tol or not atol:
+            raise argparse.ArgumentTypeError(f"bad tolerance '{item}', expected NAME=RTOL:ATOL")
+        tol[name] = (float(rtol), float(atol))
+    return tol
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("log", help="CSV log with a raw_counter_value column")
+    parser.add_argument("--lib", default=os.environ.get("GPSDO_FILTER_LIB", DEFAULT_LIB))
+    parser.add_argument("--q", type=float, help="process noise (default: firmware)")
+    parser.add_argument("--sigma-phase", type=float, help="measurement noise (default: firmware)")
+    parser.add_argument("--mahal", type=float, help="outlier threshold (default: firmware)")
+    parser.add_argument("--kernel", choices=KERNELS, default=KERNELS[0],
+                        help="filter.c predict/correct implementation")
+    parser.add_argument("--steady-state", action="store_true",
+                        help="let filter.c switch to its constant DARE gain (approximate)")
+    parser.add_argument("--short-form", action="store_true",
+                        help="filter.c P update as (I - KH)P instead of the Joseph form")
+    parser.add_argument("--adaptive", action="store_true",
+                        help="let filter.c re-estimate R and q (kalman.py keeps them fixed)")
+    parser.add_argument("--imm", action="store_true",
+                        help="run filter.c as clear sky/degraded/jammed IMM (kalman.py is one model)")
+    parser.add_argument("--reacq", type=int, default=0, metavar="N",
+                        help="let filter.c re-seed after N rejections in a row (kalman.py never does)")
+    parser.add_argument("--batch-init", type=int, default=0, metavar="N",
+                        help="let filter.c start from a least-squares fit over N samples "
+                             "(kalman.py starts from X = 0)")
+    parser.add_argument("--python-defaults", action="store_true",
+                        help="run kalman.py with its own constructor defaults")
+    parser.add_argument("--tol", action="append", metavar="NAME=RTOL:ATOL",
+                        help="tolerance for x, P, K or y (repeatable)")
+    parser.add_argument("-n", type=int, help="only the first N samples")
+    parser.add_argument("-o", "--out", help="write per-step divergence CSV")
+    args = parser.parse_args(argv)
+
+    tol = parse_tol(args.tol)
+
+    raw = load_raw_counts(args.log)
+    if args.n:
+        raw = raw[:args.n]
+
+    fw = FirmwareFilter(args.lib)
+    cfg = fw.config()
+    if args.q is not None:
+        cfg.q = args.q
+    if args.sigma_phase is not None:
+        cfg.sigma_phase = args.sigma_phase
+    if args.mahal is not None:
+        cfg.mahal_threshold = args.mahal
+    cfg.kernel = KERNELS.index(args.kernel)
+    cfg.steady_state = args.steady_state
+    cfg.joseph = not args.short_form
+    cfg.adaptive = args.adaptive
+    cfg.imm = args.imm
+    cfg.reacq_run = args.reacq
+    cfg.init_samples = args.batch_init
+    fw.set_config(cfg)
+    q, sigma_phase, mahal = cfg.q, cfg.sigma_phase, cfg.mahal_threshold
+
+    t0 = time.perf_counter()
+    c = fw.run(raw)
+    t_c = time.perf_counter() - t0
+
+    t0 = time.perf_counter()
+    if args.python_defaults:
+        ref = KalmanFilter()
+        py_cfg = (ref.Q[2, 2], float(np.sqrt(ref.R[0, 0])), ref.mahal_thd)
+    else:
+        py_cfg = (q, sigma_phase, mahal)
+    py = run_python(raw, *py_cfg)
+    t_py = time.perf_counter() - t0
+
+    print(f"{len(raw)} samples, filter.c {t_c:.3f} s, kalman.py {t_py:.3f} s")
+    print(f"filter.c : kernel={args.kernel} q={q:.3g} sigma_phase={sigma_phase:.4g} mahal={mahal:.3g}")
+    print(f"kalman.py: q={py_cfg[0]:.3g} sigma_phase={py_cfg[1]:.4g} mahal={py_cfg[2]:.3g}")
+
+    table = {"step": np.arange(len(raw))}
+    failed = False
+
+    # gains are stale on rejected steps in filter.c, compare accepted ones only
+    both_accepted = ~c["rejected"] & ~py["rejected"]
+    mismatch = c["rejected"] != py["rejected"]
+    table["reject_mismatch"] = mismatch.astype(int)
+
+    for name in ("x", "P", "K", "y"):
+        rtol, atol = tol[name]
+        err, excess = divergence(c[name], py[name], rtol, atol)
+        if name == "K":
+            err = np.where(both_accepted, err, 0.0)
+            excess = np.where(both_accepted, excess, -np.inf)
+        bad = excess > 0.0
+        table[f"{name}_err"] = err
+        first = int(np.argmax(bad)) if bad.any() else None
+        status = "ok" if first is None else f"FAIL ({bad.sum()} steps, first at {first})"
+        print(f"  {name:2s} max |err| {err.max():.3e}  (rtol {rtol:g}, atol {atol:g})  {status}")
+        failed |= first is not None
+
+    print(f"  rejections: filter.c {c['rejected'].sum()}, kalman.py {py['rejected'].sum()}, "
+          f"mismatched {mismatch.sum()}")
+    failed |= bool(mismatch.any())
+
+    if args.out:
+        np.savetxt(args.out, np.column_stack(list(table.values())), delimiter=",",
+                   header=",".join(table.keys()), comments="", fmt="%.6g")
+
+    print("EQUIVALENT" if not failed else "DIVERGED")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
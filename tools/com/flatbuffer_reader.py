@@ -6,12 +6,27 @@ from schemas.gpsdo.Message import Message
 from schemas.gpsdo.Payload import Payload
 from schemas.gpsdo.Status import Status
 from schemas.gpsdo.kf_Debug import kf_debug
+from schemas.gpsdo.Profile import Profile
+from schemas.gpsdo.kf_smooth import kf_smooth
 
 FLATBUF_MAGIC = 0xB00B
 MAX_MESSAGE_SIZE = 1024
 HEADER_FMT = "<HHH"  # little-endian: magic, msg_id, len
 HEADER_SIZE = struct.calcsize(HEADER_FMT)
 
+# profile_section_t in software/gpsdo/src/profile/profile.h
+PROFILE_SECTIONS = (
+    "pps_isr",
+    "filter_step",
+    "control",
+    "dac_set_voltage",
+    "send_status",
+    "send_kf_debug",
+    "usb_tx",
+    "pps_irq_latency",
+    "pps_read_latency",
+)
+
 
 @dataclass
 class ParsedMessage:
@@ -83,6 +98,12 @@ class FlatbufferStreamReader:
         elif payload_type == Payload.kf_debug:
             obj = kf_debug()
             obj.Init(table.Bytes, table.Pos)
+        elif payload_type == Payload.Profile:
+            obj = Profile()
+            obj.Init(table.Bytes, table.Pos)
+        elif payload_type == Payload.kf_smooth:
+            obj = kf_smooth()
+            obj.Init(table.Bytes, table.Pos)
         else:
             self.log.info(f"Unknown payload_type={payload_type}, msg_id={msg_id}, skipping")
             return None
@@ -4,7 +4,7 @@ import os
 import numpy as np
 from datetime import datetime
 from kalman import KalmanFilter
-from flatbuffer_reader import FlatbufferStreamReader
+from flatbuffer_reader import FlatbufferStreamReader, PROFILE_SECTIONS
 from schemas.gpsdo.Payload import Payload
 from realtime_plot import RealtimePlotter
 
@@ -68,6 +68,16 @@ def read_loop(ser, log):
                     log.info(f"Temperature (C): {temperature_c:.2f}")
                     log.info(f"Raw Counter: {raw_counter_value}")
 
+                    # IMM filter only: clear sky, degraded, jammed/spoofed
+                    mode_prob = status.ModeProb()
+                    if mode_prob is not None:
+                        log.info("Mode Prob: " + " ".join(
+                            f"{mode_prob.V(i):.3f}" for i in range(mode_prob.VLength())))
+
+                    # PPS capture ring: overruns are edges the controller never saw
+                    log.info(f"PPS: seq={status.PpsSeq()} overruns={status.PpsOverruns()} "
+                             f"backlog_max={status.PpsBacklogMax()} sw_reads={status.PpsSwReads()}")
+
                     timestamp = parsed.timestamp_s or (time.time() - start_time)
                     kf.predict()
                     X, P, k, y = kf.update(raw_counter_value)
@@ -101,12 +111,37 @@ def read_loop(ser, log):
                     corr = dbg.Correction()
                     log.info(
                         f"kf_debug ts={parsed.timestamp_s:.3f} iter={dbg.KfIteration()} outliers={dbg.OutlierCount()} "
+                        f"cov_repairs={dbg.CovHealthCount()} reacq={dbg.ReacqCount()} "
                         f"drift={state.Drift() if state else 'n/a'} "
                         f"z={corr.Z() if corr else 'n/a'}"
                     )
                 except Exception as e:
                     log.warning(f"Failed to parse kf_debug payload: {e}")
                     continue
+            elif parsed.payload_type == Payload.Profile:
+                prof = parsed.payload
+                sec = prof.Section()
+                name = PROFILE_SECTIONS[sec] if sec < len(PROFILE_SECTIONS) else f"section{sec}"
+                us = 1e6 / prof.CpuHz() if prof.CpuHz() else 0.0
+                hist = {1 << (prof.HistFirstBucket() + i): prof.Hist(i)
+                        for i in range(prof.HistLength()) if prof.Hist(i)}
+                log.info(
+                    f"profile {name}: n={prof.Count()} min={prof.MinCycles() * us:.2f} us "
+                    f"mean={prof.MeanCycles() * us:.2f} us max={prof.MaxCycles() * us:.2f} us "
+                    f"last={prof.LastCycles() * us:.2f} us hist={hist}"
+                )
+            elif parsed.payload_type == Payload.kf_smooth:
+                sm = parsed.payload
+                try:
+                    x, sigma, filt = sm.X(), sm.Sigma(), sm.XFilt()
+                    log.info(
+                        f"kf_smooth iter={sm.KfIteration()} lag={sm.Lag()} "
+                        f"freq={x.V(1):.6f}+-{sigma.V(1):.6f} (filter {filt.V(1):.6f}) "
+                        f"drift={x.V(2):.3e}+-{sigma.V(2):.3e} (filter {filt.V(2):.3e})"
+                    )
+                except Exception as e:
+                    log.warning(f"Failed to parse kf_smooth payload: {e}")
+                    continue
             else:
                 log.info(f"Unhandled payload_type={parsed.payload_type}, msg_id={parsed.msg_id}")
                 continue
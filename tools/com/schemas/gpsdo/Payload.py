@@ -6,3 +6,5 @@ class Payload(object):
     NONE = 0
     Status = 1
     kf_debug = 2
+    Profile = 3
+    kf_smooth = 4
@@ -0,0 +1,180 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: gpsdo
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+class Profile(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAs(cls, buf, offset=0):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = Profile()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def GetRootAsProfile(cls, buf, offset=0):
+        """This method is deprecated. Please switch to GetRootAs."""
+        return cls.GetRootAs(buf, offset)
+    # Profile
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # Profile
+    def Section(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint8Flags, o + self._tab.Pos)
+        return 0
+
+    # Profile
+    def CpuHz(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
+    # Profile
+    def Count(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
+    # Profile
+    def MinCycles(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
+    # Profile
+    def MaxCycles(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(12))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
+    # Profile
+    def MeanCycles(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(14))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Float32Flags, o + self._tab.Pos)
+        return 0.0
+
+    # Profile
+    def LastCycles(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(16))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
+    # Profile
+    def HistFirstBucket(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(18))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint8Flags, o + self._tab.Pos)
+        return 0
+
+    # Profile
+    def Hist(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(20))
+        if o != 0:
+            a = self._tab.Vector(o)
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, a + flatbuffers.number_types.UOffsetTFlags.py_type(j * 4))
+        return 0
+
+    # Profile
+    def HistAsNumpy(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(20))
+        if o != 0:
+            return self._tab.GetVectorAsNumpy(flatbuffers.number_types.Uint32Flags, o)
+        return 0
+
+    # Profile
+    def HistLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(20))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # Profile
+    def HistIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(20))
+        return o == 0
+
+def ProfileStart(builder):
+    builder.StartObject(9)
+
+def Start(builder):
+    ProfileStart(builder)
+
+def ProfileAddSection(builder, section):
+    builder.PrependUint8Slot(0, section, 0)
+
+def AddSection(builder, section):
+    ProfileAddSection(builder, section)
+
+def ProfileAddCpuHz(builder, cpuHz):
+    builder.PrependUint32Slot(1, cpuHz, 0)
+
+def AddCpuHz(builder, cpuHz):
+    ProfileAddCpuHz(builder, cpuHz)
+
+def ProfileAddCount(builder, count):
+    builder.PrependUint32Slot(2, count, 0)
+
+def AddCount(builder, count):
+    ProfileAddCount(builder, count)
+
+def ProfileAddMinCycles(builder, minCycles):
+    builder.PrependUint32Slot(3, minCycles, 0)
+
+def AddMinCycles(builder, minCycles):
+    ProfileAddMinCycles(builder, minCycles)
+
+def ProfileAddMaxCycles(builder, maxCycles):
+    builder.PrependUint32Slot(4, maxCycles, 0)
+
+def AddMaxCycles(builder, maxCycles):
+    ProfileAddMaxCycles(builder, maxCycles)
+
+def ProfileAddMeanCycles(builder, meanCycles):
+    builder.PrependFloat32Slot(5, meanCycles, 0.0)
+
+def AddMeanCycles(builder, meanCycles):
+    ProfileAddMeanCycles(builder, meanCycles)
+
+def ProfileAddLastCycles(builder, lastCycles):
+    builder.PrependUint32Slot(6, lastCycles, 0)
+
+def AddLastCycles(builder, lastCycles):
+    ProfileAddLastCycles(builder, lastCycles)
+
+def ProfileAddHistFirstBucket(builder, histFirstBucket):
+    builder.PrependUint8Slot(7, histFirstBucket, 0)
+
+def AddHistFirstBucket(builder, histFirstBucket):
+    ProfileAddHistFirstBucket(builder, histFirstBucket)
+
+def ProfileAddHist(builder, hist):
+    builder.PrependUOffsetTRelativeSlot(8, flatbuffers.number_types.UOffsetTFlags.py_type(hist), 0)
+
+def AddHist(builder, hist):
+    ProfileAddHist(builder, hist)
+
+def ProfileStartHistVector(builder, numElems):
+    return builder.StartVector(4, numElems, 4)
+
+def StartHistVector(builder, numElems):
+    return ProfileStartHistVector(builder, numElems)
+
+def ProfileEnd(builder):
+    return builder.EndObject()
+
+def End(builder):
+    return ProfileEnd(builder)
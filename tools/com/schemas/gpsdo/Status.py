@@ -73,8 +73,47 @@ class Status(object):
             return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
         return 0
 
+    # Status
+    def ModeProb(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(18))
+        if o != 0:
+            x = self._tab.Indirect(o + self._tab.Pos)
+            from gpsdo.Vec3 import Vec3
+            obj = Vec3()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # Status
+    def PpsSeq(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(20))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
+    # Status
+    def PpsOverruns(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(22))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
+    # Status
+    def PpsBacklogMax(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(24))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
+    # Status
+    def PpsSwReads(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(26))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
 def StatusStart(builder):
-    builder.StartObject(7)
+    builder.StartObject(12)
 
 def Start(builder):
     StatusStart(builder)
@@ -121,6 +160,36 @@ def StatusAddRawCounterValue(builder, rawCounterValue):
 def AddRawCounterValue(builder, rawCounterValue):
     StatusAddRawCounterValue(builder, rawCounterValue)
 
+def StatusAddModeProb(builder, modeProb):
+    builder.PrependUOffsetTRelativeSlot(7, flatbuffers.number_types.UOffsetTFlags.py_type(modeProb), 0)
+
+def AddModeProb(builder, modeProb):
+    StatusAddModeProb(builder, modeProb)
+
+def StatusAddPpsSeq(builder, ppsSeq):
+    builder.PrependUint32Slot(8, ppsSeq, 0)
+
+def AddPpsSeq(builder, ppsSeq):
+    StatusAddPpsSeq(builder, ppsSeq)
+
+def StatusAddPpsOverruns(builder, ppsOverruns):
+    builder.PrependUint32Slot(9, ppsOverruns, 0)
+
+def AddPpsOverruns(builder, ppsOverruns):
+    StatusAddPpsOverruns(builder, ppsOverruns)
+
+def StatusAddPpsBacklogMax(builder, ppsBacklogMax):
+    builder.PrependUint32Slot(10, ppsBacklogMax, 0)
+
+def AddPpsBacklogMax(builder, ppsBacklogMax):
+    StatusAddPpsBacklogMax(builder, ppsBacklogMax)
+
+def StatusAddPpsSwReads(builder, ppsSwReads):
+    builder.PrependUint32Slot(11, ppsSwReads, 0)
+
+def AddPpsSwReads(builder, ppsSwReads):
+    StatusAddPpsSwReads(builder, ppsSwReads)
+
 def StatusEnd(builder):
     return builder.EndObject()
 
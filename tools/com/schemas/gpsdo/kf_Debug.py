@@ -107,8 +107,22 @@ class kf_debug(object):
             return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
         return 0
 
+    # kf_debug
+    def CovHealthCount(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(22))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
+    # kf_debug
+    def ReacqCount(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(24))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
 def kf_debugStart(builder):
-    builder.StartObject(9)
+    builder.StartObject(11)
 
 def Start(builder):
     kf_debugStart(builder)
@@ -167,6 +181,18 @@ def kf_debugAddKfIteration(builder, kfIteration):
 def AddKfIteration(builder, kfIteration):
     kf_debugAddKfIteration(builder, kfIteration)
 
+def kf_debugAddCovHealthCount(builder, covHealthCount):
+    builder.PrependUint32Slot(9, covHealthCount, 0)
+
+def AddCovHealthCount(builder, covHealthCount):
+    kf_debugAddCovHealthCount(builder, covHealthCount)
+
+def kf_debugAddReacqCount(builder, reacqCount):
+    builder.PrependUint32Slot(10, reacqCount, 0)
+
+def AddReacqCount(builder, reacqCount):
+    kf_debugAddReacqCount(builder, reacqCount)
+
 def kf_debugEnd(builder):
     return builder.EndObject()
 
@@ -0,0 +1,127 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: gpsdo
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+class kf_smooth(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAs(cls, buf, offset=0):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = kf_smooth()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def GetRootAskf_smooth(cls, buf, offset=0):
+        """This method is deprecated. Please switch to GetRootAs."""
+        return cls.GetRootAs(buf, offset)
+    # kf_smooth
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # kf_smooth
+    def TimestampS(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Float64Flags, o + self._tab.Pos)
+        return 0.0
+
+    # kf_smooth
+    def KfIteration(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
+    # kf_smooth
+    def Lag(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint16Flags, o + self._tab.Pos)
+        return 0
+
+    # kf_smooth
+    def X(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        if o != 0:
+            x = self._tab.Indirect(o + self._tab.Pos)
+            from gpsdo.Vec3 import Vec3
+            obj = Vec3()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # kf_smooth
+    def Sigma(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(12))
+        if o != 0:
+            x = self._tab.Indirect(o + self._tab.Pos)
+            from gpsdo.Vec3 import Vec3
+            obj = Vec3()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # kf_smooth
+    def XFilt(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(14))
+        if o != 0:
+            x = self._tab.Indirect(o + self._tab.Pos)
+            from gpsdo.Vec3 import Vec3
+            obj = Vec3()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+def kf_smoothStart(builder):
+    builder.StartObject(6)
+
+def Start(builder):
+    kf_smoothStart(builder)
+
+def kf_smoothAddTimestampS(builder, timestampS):
+    builder.PrependFloat64Slot(0, timestampS, 0.0)
+
+def AddTimestampS(builder, timestampS):
+    kf_smoothAddTimestampS(builder, timestampS)
+
+def kf_smoothAddKfIteration(builder, kfIteration):
+    builder.PrependUint32Slot(1, kfIteration, 0)
+
+def AddKfIteration(builder, kfIteration):
+    kf_smoothAddKfIteration(builder, kfIteration)
+
+def kf_smoothAddLag(builder, lag):
+    builder.PrependUint16Slot(2, lag, 0)
+
+def AddLag(builder, lag):
+    kf_smoothAddLag(builder, lag)
+
+def kf_smoothAddX(builder, x):
+    builder.PrependUOffsetTRelativeSlot(3, flatbuffers.number_types.UOffsetTFlags.py_type(x), 0)
+
+def AddX(builder, x):
+    kf_smoothAddX(builder, x)
+
+def kf_smoothAddSigma(builder, sigma):
+    builder.PrependUOffsetTRelativeSlot(4, flatbuffers.number_types.UOffsetTFlags.py_type(sigma), 0)
+
+def AddSigma(builder, sigma):
+    kf_smoothAddSigma(builder, sigma)
+
+def kf_smoothAddXFilt(builder, xFilt):
+    builder.PrependUOffsetTRelativeSlot(5, flatbuffers.number_types.UOffsetTFlags.py_type(xFilt), 0)
+
+def AddXFilt(builder, xFilt):
+    kf_smoothAddXFilt(builder, xFilt)
+
+def kf_smoothEnd(builder):
+    return builder.EndObject()
+
+def End(builder):
+    return kf_smoothEnd(builder)